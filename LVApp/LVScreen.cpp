@@ -1,10 +1,14 @@
 #include "LVScreen.h"
 #include "LVScreenTask.h"
+#include "LVScreenScript.h"
+#include "LVScreenCache.h"
+#include "LVScreenStack.h"
 #include <LVObjx/LVBar.h>
 #include <LVObjx/LVLabel.h>
 #include <LVCore/LVStyle.h>
 #include <LVObjx/LVMessageBox.h>
 #include <LVCore/LVDispaly.h>
+#include <lv_objx/lv_page.h>
 
 LVPointer<LVScreen> LVScreen::s_lastScreen;
 LVPointer<LVScreen> LVScreen::s_currScreen;
@@ -29,13 +33,45 @@ void LVScreen::setClearAfterHide(bool clearAfterHide)
     m_clearAfterHide = clearAfterHide;
 }
 
+bool LVScreen::isUseArena() const
+{
+    return m_useArena;
+}
+
+void LVScreen::setUseArena(bool value)
+{
+    m_useArena = value;
+}
+
+LVMemoryArena *LVScreen::arena() const
+{
+    return m_arena;
+}
+
 void LVScreen::cleanScreen()
 {
     //memory_monitor(nullptr);
 
     //NOTE: 注意清理的先后顺序
 
-    beforeCleanScreen();
+    //分步清理还没完成时,剩余部分一次完成
+    if(m_cleaning)
+    {
+        LVVector<LVScreen *> & queue = cleanQueue();
+        for (uint32_t i = 0; i < queue.size(); ++i)
+        {
+            if(queue[i] == this)
+            {
+                queue.erase(queue.begin() + i);
+                break;
+            }
+        }
+    }
+    else
+    {
+        storeState();
+        beforeCleanScreen();
+    }
 
     //清理屏幕任务
     cleanTaskList();
@@ -43,11 +79,153 @@ void LVScreen::cleanScreen()
     //清理子对象
     cleanChildren();
 
+    finishCleanScreen();
+}
+
+void LVScreen::cleanScreenLater()
+{
+    if(m_cleaning)
+        return;
+
+    storeState();
+    beforeCleanScreen();
+
+    //屏幕立即变为未初始化,再次显示时先完成清理
+    setInited(false);
+    m_setupStep = 0;
+    m_cleaning = true;
+    m_memoryRecovered = 0;
+
+    //清理队列和任务是全局的,不进入屏幕内存区
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    cleanQueue().push_back(this);
+    static LVTask * s_cleanTask = nullptr;
+    if(s_cleanTask == nullptr)
+        s_cleanTask = new LVTask(cleanQueueStep,LV_SCREEN_CLEAN_PERIOD,LVTask::PRIO_LOW);
+    LVMemoryArena::resume(arena);
+
+    if(!s_cleanTask->isRunning())
+        s_cleanTask->start();
+}
+
+bool LVScreen::isDeferredClean() const
+{
+    return m_deferredClean;
+}
+
+void LVScreen::setDeferredClean(bool value)
+{
+    m_deferredClean = value;
+}
+
+/**
+ * 可以逐个删除子对象的对象,其他控件的子对象可能被控件内部引用,整体删除
+ */
+static lv_obj_t * cleanableParent(lv_obj_t * obj)
+{
+    lv_obj_type_t type;
+    lv_obj_get_type(obj,&type);
+    if(strcmp(type.type[0],"lv_obj") == 0 || strcmp(type.type[0],"lv_cont") == 0)
+        return obj;
+#if LV_USE_PAGE
+    //页面的内容在可滚动对象中
+    if(strcmp(type.type[0],"lv_page") == 0)
+        return lv_page_get_scrl(obj);
+#endif
+    return nullptr;
+}
+
+bool LVScreen::cleanSlice(uint32_t timeLimit)
+{
+    uint32_t start = lv_tick_get();
+    do
+    {
+        //先删除任务
+        if(!m_taskList.empty())
+        {
+            LVScreenTask * task = m_taskList.back();
+            m_taskList.pop_back();
+            task->m_taskIndex = -1;
+            task->m_screen = nullptr;
+            delete task;
+            continue;
+        }
+
+        lv_obj_t * obj = lv_obj_get_child(this,nullptr);
+        if(obj == nullptr)
+        {
+            m_taskList.shrink_to_fit();
+            return true;
+        }
+
+        //向下找到一个可以单独删除的对象,一次只删除一小部分
+        for(;;)
+        {
+            lv_obj_t * parent = cleanableParent(obj);
+            lv_obj_t * child = parent ? lv_obj_get_child(parent,nullptr) : nullptr;
+            if(child == nullptr)
+                break;
+            obj = child;
+        }
+        lv_obj_del(obj);
+    }
+    while (lv_tick_elaps(start) < timeLimit);
+
+    return false;
+}
+
+bool LVScreen::isSaveState() const
+{
+    return m_saveState;
+}
+
+void LVScreen::setSaveState(bool value)
+{
+    m_saveState = value;
+}
+
+void LVScreen::saveState(LVScreenState &state)
+{
+    state.saveChildren(this);
+}
+
+bool LVScreen::restoreState(LVScreenState &state)
+{
+    return state.restoreChildren(this);
+}
+
+void LVScreen::clearState()
+{
+    m_state.clear();
+}
+
+void LVScreen::storeState()
+{
+    //已经保存过,或者屏幕没有内容
+    if(!m_inited || !m_state.isEmpty())
+        return;
+    if(!m_saveState && !LVScreenStack::contains(this))
+        return;
+
+    saveState(m_state);
+    m_state.finish();
+    lvInfo("Screen [%s] state saved : %d Bytes",m_name,m_state.size());
+}
+
+void LVScreen::finishCleanScreen()
+{
+    m_cleaning = false;
+
     //触发子类清理动作
     afterCleanScreen();
 
+    //整块归还屏幕内存区
+    if(m_arenaUsed && !m_arena->release())
+        lvWarn("Screen [%s] arena has %d allocations alive, release later.",m_name,m_arena->liveCount());
+
     //重置初始化标识
     setInited(false);
+    m_setupStep = 0;
 
     //整理内存碎片
     //lv_mem_defrag();
@@ -86,6 +264,9 @@ void LVScreen::setName(const char *name)
 
 LVBar * LVScreen::memoryDebuger()
 {
+    //全局对象不进入屏幕内存区
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+
     //用进度条指示内存状态
     static LVPointer<LVBar> barMem(true) ;
     static LVScopedPointer<LVTask> memTask ;
@@ -170,6 +351,7 @@ LVBar * LVScreen::memoryDebuger()
     //sprintf(tempStr,"Use:%dByte",screen->m_memoryUsed);
     //showBubble(tempStr,1000);
 
+    LVMemoryArena::resume(arena);
     return barMem;
 }
 
@@ -178,6 +360,9 @@ LVLabel *LVScreen::bubble(bool create)
     static LVPointer<LVLabel> bubble(true);
     static LVScopedPointer<LVStyle> styleBubble;
 
+    //全局对象不进入屏幕内存区
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+
     if(!styleBubble && create)
     {
         //NOTE:主题刷新时无法更新样式
@@ -206,6 +391,7 @@ LVLabel *LVScreen::bubble(bool create)
         bubble->setStyle(styleBubble);
     }
 
+    LVMemoryArena::resume(arena);
     return bubble;
 }
 
@@ -216,11 +402,13 @@ void LVScreen::showBubble(const char *mesg, int32_t period)
     static LVScopedPointer<LVTask> bubbleTask;
     if(!bubbleTask)
     {
+        LVMemoryArena * arena = LVMemoryArena::suspend();
         bubbleTask.reset(new LVTask(
         [&](LVTask*){
             bubble()->setHidden(true);
             bubbleTask->stop();
         },period));
+        LVMemoryArena::resume(arena);
     }
 
     auto * bubbleLab = bubble();
@@ -241,7 +429,9 @@ void LVScreen::showMessageBox(const char *mesg, const char **buts, const LVEvent
     //配置消息框遮罩
     if(masked && !mask)
     {
+        LVMemoryArena * arena = LVMemoryArena::suspend();
         mask.reset(setupMask(mbox->getParent()));
+        LVMemoryArena::resume(arena);
 
         mbox->setSignalCallBack([&](LVObject * obj, SignalType sign, void * param)->LVResult
         {
@@ -289,11 +479,14 @@ LVMessageBox *LVScreen::messageBox(bool create)
     static LVPointer<LVMessageBox> mbox(true);
     if(!mbox && create)
     {
+        //全局对象不进入屏幕内存区
+        LVMemoryArena * arena = LVMemoryArena::suspend();
         mbox.reset(new LVMessageBox(LVDisplay::getDefault()->getLayerTop()));
         //增加消息框的宽度
         mbox->setWidth(LVDisplay::getDefault()->getHorizontalResolution() - 40);
         mbox->align(ALIGN_CENTER);
         mbox->setHidden(true);
+        LVMemoryArena::resume(arena);
     }
     return mbox;
 }
@@ -305,7 +498,9 @@ LVObject * LVScreen::setupMask(LVObject *parent)
     if(!maskStyle)
     {
         //NOTE:切换主题时可能无法更新样式
+        LVMemoryArena * arena = LVMemoryArena::suspend();
         maskStyle.reset(new LVStyle());
+        LVMemoryArena::resume(arena);
         *maskStyle = lv_style_plain;
         maskStyle->body.opa = 200;
         maskStyle->body.main_color = LV_COLOR_GRAY;
@@ -322,7 +517,6 @@ LVObject * LVScreen::setupMask(LVObject *parent)
 
 LVScreen::LVScreen(const char *name, LVObject *parent)
     : LVObject(parent)
-    ,m_taskList(sizeof (LVScreenTask *))
 {
     setName(name);
     //设置事件处理函数
@@ -332,9 +526,25 @@ LVScreen::LVScreen(const char *name, LVObject *parent)
 
 LVScreen::~LVScreen()
 {
+#if LV_USE_SCREEN_SCRIPT
+    LVScreenScript::cancelScreen(this);
+#endif
+    //从屏幕缓存和预加载队列中移除
+    LVScreenCache::remove(this);
+    //删除时不需要保存状态
+    LVScreenStack::remove(this);
+    m_saveState = false;
+
     //清理掉数据和任务
     cleanScreen();
 
+    //内存区在剩余的分配释放后自动删除
+    if(m_arena)
+    {
+        m_arena->drop();
+        m_arena = nullptr;
+    }
+
     //清除自己在其他地方的记录
     if(LastScreen() == this)
         setLastScreen(nullptr);
@@ -397,29 +607,133 @@ bool LVScreen::setupScreen()
     return false;
 }
 
+LVScreen::SetupResult LVScreen::setupScreenStep(uint32_t /*step*/)
+{
+    return setupScreen() ? SETUP_DONE : SETUP_FAILED;
+}
+
+bool LVScreen::prepare(uint32_t timeLimit)
+{
+    //分步清理还没完成
+    if(m_cleaning)
+        cleanScreen();
+
+    if(m_inited)
+        return true;
+
+    //统计初始化屏幕用了多少内存
+    //方便在屏幕清理的时候发现内存泄露
+    if(m_setupStep == 0)
+    {
+        m_memoryUsed = 0;
+        m_arenaUsed = m_useArena;
+    }
+    int32_t memoryUsed = getUsedMemorySize();
+    if(m_arenaUsed)
+    {
+        if(m_arena == nullptr)
+            m_arena = new LVMemoryArena();
+        //上一次的内存区还在等待归还,这次初始化直接在LVGL堆上
+        if(!m_arena->begin())
+        {
+            lvWarn("Screen [%s] arena is not released yet, setup on LVGL heap.",m_name);
+            m_arenaUsed = false;
+        }
+    }
+#if LV_USE_MEMORY_TRACE
+    //初始化期间的分配记在这个屏幕上
+    LVMemoryTrace::setScope(m_name);
+#endif
+
+    uint32_t start = lv_tick_get();
+    SetupResult result;
+    do
+    {
+        result = setupScreenStep(m_setupStep++);
+    }
+    while (result == SETUP_CONTINUE && lv_tick_elaps(start) < timeLimit);
+
+    //重新初始化后恢复清理前保存的状态,恢复时的分配也记在屏幕上
+    if(result == SETUP_DONE && !m_state.isEmpty())
+    {
+        m_state.rewind();
+        if(!restoreState(m_state))
+            lvWarn("Screen [%s] state does not match, restore stopped.",m_name);
+    }
+
+    if(m_arenaUsed)
+        m_arena->end();
+#if LV_USE_MEMORY_TRACE
+    //预加载时恢复当前屏幕的记录
+    LVMemoryTrace::setScope(CurrScreen() ? CurrScreen()->name() : nullptr);
+#endif
+    m_memoryUsed += getUsedMemorySize() - memoryUsed;
+
+    if(result == SETUP_CONTINUE)
+        return false;
+
+    //状态只使用一次,不计入屏幕的内存
+    m_state.clear();
+
+    m_setupStep = 0;
+    m_inited = result == SETUP_DONE;
+    {
+        char str[40];
+        //警告内存有泄露
+        sprintf(str,"Memory used : %d Bytes!", m_memoryUsed);
+        lvWarn(str);
+    }
+
+    if(!m_inited)
+        lvInfo("Screen::prepare() setupScreen false");
+    return m_inited;
+}
+
 bool LVScreen::show()
 {
     bool ret = false;
 
+#if LV_USE_SCREEN_TRANSITION
+    //上一次切换还没结束时,快照已经不是要切换的画面
+    LVScreenTransition::finish();
+    //旧屏幕隐藏时可能被清理,先抓取正在显示的画面
+    if(CurrScreen() && m_transition != LVScreenTransition::EFFECT_NONE)
+        LVScreenTransition::capture();
+#endif
+
     //如果存在其他的屏幕界面正在显示,需要先隐藏当前的界面
     if(CurrScreen())
     {
         if(!CurrScreen()->hide())
         {
             //界面未隐藏成功,当前界面无法显示
+#if LV_USE_SCREEN_TRANSITION
+            LVScreenTransition::release();
+#endif
             return ret;
         }
     }
 
     if(beforeShow())
     {
+        //显示中的屏幕不能被缓存清理
+        LVScreenCache::remove(this);
         loadScreen();
+#if LV_USE_SCREEN_TRANSITION
+        LVScreenTransition::start(m_transition,m_transitionTime);
+#endif
         setCurrScreen(this);
         //开启相关任务
         startScreenTask();
         afterShow();
         ret = true;
     }
+#if LV_USE_SCREEN_TRANSITION
+    else
+    {
+        LVScreenTransition::release();
+    }
+#endif
 
     return ret;
 }
@@ -436,26 +750,9 @@ bool LVScreen::beforeShow()
     //初始化界面
     //将初始化放到这理执行,有助于减少内存占用情况
     //没有用到的界面就不会消耗内存了
+    //预加载未完成的剩余步骤在这里一次完成
     if(!m_inited)
-    {
-        //统计初始化屏幕用了多少内存
-        //方便在屏幕清理的时候发现内存泄露
-        //memory_monitor(nullptr);
-        m_memoryUsed = getUsedMemorySize();
-        m_inited = setupScreen();
-        m_memoryUsed = getUsedMemorySize() - m_memoryUsed;
-        //memory_monitor(nullptr);
-
-        {
-            char str[40];
-            //警告内存有泄露
-            sprintf(str,"Memory used : %d Bytes!", m_memoryUsed);
-            lvWarn(str);
-        }
-
-        if(!m_inited)
-            lvInfo("Screen::beforeShow() setupScreen false");
-    }
+        prepare();
 
     return true;
 }
@@ -471,9 +768,21 @@ bool LVScreen::hide()
         setCurrScreen(nullptr);
         setLastScreen(this);
 
+        //隐藏后保留在屏幕缓存中,内存紧张时再清理
+        if(isClearAfterHide() && m_keepWarm && !isDeleteAfterHide())
+        {
+            LVScreenCache::retain(this);
+        }
         //隐藏后清理屏幕
-        if(isClearAfterHide())
+        //隐藏后分步清理,不阻塞下一个屏幕的显示
+        else if(isClearAfterHide() && m_deferredClean && !isDeleteAfterHide())
+        {
+            cleanScreenLater();
+        }
+        else if(isClearAfterHide())
         {
+            //状态不是屏幕内容的一部分,在统计之前保存
+            storeState();
             int32_t memoryRecovery = getUsedMemorySize();
             cleanScreen();
             memoryRecovery = memoryRecovery - getUsedMemorySize();
@@ -584,6 +893,24 @@ void LVScreen::setScreenColor(LVColor color)
     //TODO: 完成屏幕颜色设置
 }
 
+bool LVScreen::isKeepWarm() const
+{
+    return m_keepWarm;
+}
+
+void LVScreen::setKeepWarm(bool value)
+{
+    m_keepWarm = value;
+}
+
+#if LV_USE_SCREEN_TRANSITION
+void LVScreen::setTransition(LVScreenTransition::Effect effect, uint16_t time)
+{
+    m_transition = effect;
+    m_transitionTime = time;
+}
+#endif
+
 bool LVScreen::isDeleteAfterHide()
 {
     return m_deleteAfterHide;
@@ -617,65 +944,101 @@ void LVScreen::setLastScreen(LVScreen *screen)
 void LVScreen::setCurrScreen(LVScreen *screen)
 {
     s_currScreen.reset(screen);
+#if LV_USE_MEMORY_TRACE
+    LVMemoryTrace::setScope(screen ? screen->name() : nullptr);
+#endif
 }
 
 void LVScreen::startScreenTask()
 {
-    auto node = m_taskList.getHead();
-    while (node)
-    {
-        LVScreenTask * task = node->data();
-        task->onScreenShow();
-        node = m_taskList.getNext(node);
-    }
+    for (size_t i = 0; i < m_taskList.size(); ++i)
+        m_taskList[i]->onScreenShow();
 }
 
 void LVScreen::stopScreenTask()
 {
-    auto node = m_taskList.getHead();
-    while (node)
-    {
-        LVScreenTask * task = node->data();
-        task->onScreenHide();
-        node = m_taskList.getNext(node);
-    }
+#if LV_USE_SCREEN_SCRIPT
+    //屏幕隐藏时取消屏幕脚本
+    LVScreenScript::cancelScreen(this);
+#endif
+    for (size_t i = 0; i < m_taskList.size(); ++i)
+        m_taskList[i]->onScreenHide();
 }
 
 void LVScreen::loginTask(LVScreenTask *task)
 {
-    if(task && !task->m_nodeId)
+    if(task && task->m_taskIndex < 0)
     {
-        auto newNode =  m_taskList.insertTail();
-        //保存节点指针
-        task->m_nodeId = newNode;
-        //保存任务指针
-        newNode->data() = task;
+        //保存在列表中的位置
+        task->m_taskIndex = m_taskList.size();
+        m_taskList.push_back(task);
     }
 }
 
 void LVScreen::logoutTask(LVScreenTask *task)
 {
-    if(task && task->m_nodeId)
+    if(task && task->m_taskIndex >= 0)
     {
-        m_taskList.remove(task->m_nodeId);
+        //用最后一个任务填补空位,不移动其他任务
+        LVScreenTask * last = m_taskList.back();
+        m_taskList[task->m_taskIndex] = last;
+        last->m_taskIndex = task->m_taskIndex;
+        m_taskList.pop_back();
+
         task->m_screen = nullptr;
-        task->m_nodeId = nullptr;
+        task->m_taskIndex = -1;
+    }
+}
+
+LVVector<LVScreen *> &LVScreen::cleanQueue()
+{
+    static LVVector<LVScreen *> s_cleanQueue;
+    return s_cleanQueue;
+}
+
+void LVScreen::cleanQueueStep(LVTask *task)
+{
+    LVVector<LVScreen *> & queue = cleanQueue();
+    if(queue.empty())
+    {
+        task->stop();
+        return;
+    }
+
+    LVScreen * screen = queue[0];
+    int32_t memoryUsed = getUsedMemorySize();
+    bool done = screen->cleanSlice(LV_SCREEN_CLEAN_SLICE);
+    screen->m_memoryRecovered += memoryUsed - getUsedMemorySize();
+    if(!done)
+        return;
+
+    queue.erase(queue.begin());
+    memoryUsed = getUsedMemorySize();
+    screen->finishCleanScreen();
+    screen->m_memoryRecovered += memoryUsed - getUsedMemorySize();
+
+    //只统计这个屏幕释放的内存,期间其他屏幕的申请不影响结果
+    if(screen->m_memoryUsed != screen->m_memoryRecovered)
+    {
+        char str[40];
+        //警告内存有泄露
+        sprintf(str,"Memory leak deteted : %d Bytes!", screen->m_memoryUsed - screen->m_memoryRecovered);
+        lvWarn(str);
     }
 }
 
 void LVScreen::cleanTaskList()
 {
-    auto node = m_taskList.getHead();
-    while (node)
+    for (size_t i = 0; i < m_taskList.size(); ++i)
     {
-        LVScreenTask * task = node->data();
-        task->m_nodeId = nullptr;
+        LVScreenTask * task = m_taskList[i];
+        task->m_taskIndex = -1;
         task->m_screen = nullptr;
         delete task;
-        node = m_taskList.getNext(node);
     }
 
     m_taskList.clear();
+    m_taskList.shrink_to_fit();
 }
 
 void LVScreen::setInited(bool value)
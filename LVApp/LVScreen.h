@@ -6,13 +6,30 @@
 #include <LVCore/LVScopedPointer.h>
 #include <LVCore/LVSharedPointer.h>
 #include <LVMisc/LVLinkList.h>
+#include <LVMisc/lvvector.h>
 #include <LVMisc/LVColor.h>
 #include <LVObjx/LVMessageBox.h>
 #include <LVObjx/LVBar.h>
 #include "LVScreenTask.h"
+#include "LVScreenTransition.h"
+#include "LVScreenState.h"
 #include "i18n.h"
 
 
+/**
+ * 分步清理屏幕时每次占用的时间(毫秒)
+ */
+#ifndef LV_SCREEN_CLEAN_SLICE
+#define LV_SCREEN_CLEAN_SLICE 4
+#endif
+
+/**
+ * 分步清理屏幕的任务周期(毫秒)
+ */
+#ifndef LV_SCREEN_CLEAN_PERIOD
+#define LV_SCREEN_CLEAN_PERIOD LV_DISP_DEF_REFR_PERIOD
+#endif
+
 extern const char * btnMap_Close_S   [2];
 extern const char * btnMap_Ok_S      [2];
 extern const char * btnMap_No_Yes_S  [3];
@@ -45,6 +62,20 @@ protected:
     bool m_deleteAfterHide = false; //!< 隐藏后清理屏幕数据
     bool m_clearAfterHide = true; //!< 隐藏后清理屏幕(子对象)数据
     int32_t m_memoryUsed = -1; //!< 统计内存消耗
+    bool m_useArena = false; //!< 在屏幕内存区中初始化屏幕
+    LVMemoryArena * m_arena = nullptr; //!< 屏幕内存区,清理屏幕时整块归还
+    bool m_arenaUsed = false; //!< 本次初始化的分配在屏幕内存区中
+    uint32_t m_setupStep = 0; //!< 分步初始化的下一步,0表示未开始
+    bool m_keepWarm = false; //!< 隐藏后保留在屏幕缓存中,内存紧张时再清理
+    bool m_deferredClean = false; //!< 隐藏后分步清理屏幕
+    bool m_cleaning = false; //!< 正在分步清理
+    int32_t m_memoryRecovered = 0; //!< 分步清理已回收的内存
+    bool m_saveState = false; //!< 清理时保存控件状态
+    LVScreenState m_state; //!< 清理时保存的控件状态,重新初始化后恢复
+#if LV_USE_SCREEN_TRANSITION
+    LVScreenTransition::Effect m_transition = LVScreenTransition::EFFECT_NONE; //!< 显示时的切换效果
+    uint16_t m_transitionTime = LV_SCREEN_TRANSITION_TIME; //!< 切换时间
+#endif
 
     //////////// 外观属性 /////////////////
     LVColor m_screenColor; //!< 屏幕颜色
@@ -57,7 +88,7 @@ protected:
     static LVPointer<LVScreen> s_currScreen; //!< 当前显示的屏幕
 
     /////////// 任务列表 ////////////
-    LVLinkList<LVScreenTask*> m_taskList; //!< 屏幕拥有的任务列表
+    LVVector<LVScreenTask*> m_taskList; //!< 屏幕拥有的任务列表
 
 
     //////////// 内存调试 //////////////////
@@ -83,6 +114,16 @@ protected:
 
 public:
 
+    /**
+     * @brief 分步初始化的结果
+     */
+    enum SetupResult : uint8_t
+    {
+        SETUP_DONE,     //!< 初始化完成
+        SETUP_CONTINUE, //!< 还有后续步骤
+        SETUP_FAILED,   //!< 初始化失败
+    };
+
     /**
      * @brief The CustomSignal enum
      */
@@ -210,6 +251,39 @@ public:
 
     bool isInited(){ return m_inited; }
 
+    /**
+     * @brief 是否正在分步初始化
+     * @return
+     */
+    bool isPreparing() const { return m_setupStep != 0; }
+
+    /**
+     * @brief 初始化屏幕,可以分多次完成
+     * 每次至少执行一步,用时超过 timeLimit 后在步骤之间返回,下次继续
+     * @param timeLimit 本次的时间(毫秒)
+     * @return 是否已完成初始化
+     */
+    bool prepare(uint32_t timeLimit = UINT32_MAX);
+
+    /**
+     * @brief 隐藏后是否保留在屏幕缓存中
+     * 保留的屏幕再次显示时不需要重新初始化,内存超出 LVScreenCache 的预算时清理最久未用的
+     * @return
+     */
+    bool isKeepWarm() const;
+    void setKeepWarm(bool value = true);
+
+#if LV_USE_SCREEN_TRANSITION
+    /**
+     * @brief 显示这个屏幕时的切换效果
+     * 切换前抓取旧屏幕的画面,切换过程中只移动快照,见 LVScreenTransition
+     * @param effect
+     * @param time 切换时间(毫秒)
+     */
+    void setTransition(LVScreenTransition::Effect effect, uint16_t time = LV_SCREEN_TRANSITION_TIME);
+    LVScreenTransition::Effect transition() const { return m_transition; }
+#endif
+
     /**
      * @brief 获取屏幕宽度
      * @return
@@ -243,11 +317,67 @@ public:
     bool isClearAfterHide() const;
     void setClearAfterHide(bool isClearAfterHide);
 
+    /**
+     * @brief 是否使用屏幕内存区
+     * 使用时 setupScreen() 中创建的对象从屏幕内存区中分配,
+     * cleanScreen() 时整块归还,避免屏幕切换产生内存碎片
+     * @return
+     */
+    bool isUseArena() const;
+    void setUseArena(bool value = true);
+
+    /**
+     * @brief 屏幕内存区
+     * @return 未使用时返回nullptr
+     */
+    LVMemoryArena * arena() const;
+
     /**
      * @brief 清除屏幕界面的数据,但是不删除屏幕本身
      */
     void cleanScreen();
 
+    /**
+     * @brief 分步清理屏幕
+     * 屏幕立即变为未初始化,任务和子对象在之后的任务周期中分批删除,
+     * 每次不超过 LV_SCREEN_CLEAN_SLICE 毫秒;清理完成前再次显示或调用 cleanScreen() 时,剩余部分一次完成
+     */
+    void cleanScreenLater();
+
+    /**
+     * @brief 是否正在分步清理
+     * @return
+     */
+    bool isCleaning() const { return m_cleaning; }
+
+    /**
+     * @brief 隐藏后是否分步清理屏幕
+     * 子对象很多的屏幕(长列表,表格等)一次清理会阻塞下一个屏幕的显示
+     * @return
+     */
+    bool isDeferredClean() const;
+    void setDeferredClean(bool value = true);
+
+    /**
+     * @brief 清理时是否保存控件状态
+     * 保存后重新初始化时恢复滚动位置,选中项和输入的内容;在 LVScreenStack 中的屏幕总是保存
+     * @return
+     */
+    bool isSaveState() const;
+    void setSaveState(bool value = true);
+
+    /**
+     * @brief 保存的状态
+     * @return
+     */
+    const LVScreenState & state() const { return m_state; }
+
+    /**
+     * @brief 丢弃保存的状态,下次初始化不再恢复
+     * 屏幕从 LVScreenStack 中移除且不会返回时调用
+     */
+    void clearState();
+
     /**
      * @brief 获取已用内存
      * @return
@@ -337,6 +467,30 @@ protected:
      */
     virtual bool setupScreen();
 
+    /**
+     * @brief 保存控件状态,在清理前调用
+     * 默认按顺序保存所有子对象的状态,子类可以在之后写入自己的数据
+     * @param state
+     */
+    virtual void saveState(LVScreenState & state);
+
+    /**
+     * @brief 恢复控件状态,在重新初始化后调用
+     * 读取的顺序与 saveState() 相同
+     * @param state
+     * @return 数据与控件不一致时返回false
+     */
+    virtual bool restoreState(LVScreenState & state);
+
+    /**
+     * @brief 分步初始化屏幕
+     * 预加载时在空闲的任务中分多次调用,每一步应该很短(比如创建一组控件),
+     * 默认一步调用 setupScreen()
+     * @param step 从0开始的步骤
+     * @return
+     */
+    virtual SetupResult setupScreenStep(uint32_t step);
+
     /**
      * @brief 设置之前显示的屏幕
      * @param screen
@@ -374,6 +528,30 @@ protected:
      */
     void cleanTaskList();
 
+    /**
+     * @brief 需要时在清理前保存控件状态
+     */
+    void storeState();
+
+    /**
+     * @brief 清理的最后一步
+     */
+    void finishCleanScreen();
+
+    /**
+     * @brief 分步清理一次
+     * @param timeLimit 本次的时间(毫秒)
+     * @return 是否已清理完所有任务和子对象
+     */
+    bool cleanSlice(uint32_t timeLimit);
+
+    /**
+     * @brief 等待分步清理的屏幕
+     */
+    static LVVector<LVScreen *> & cleanQueue();
+
+    static void cleanQueueStep(LVTask * task);
+
     /**
      * @brief 设置屏幕初始化标识
      * @param value
@@ -0,0 +1,192 @@
+#include "LVScreenCache.h"
+#include "LVScreen.h"
+#include <LVMisc/LVMemoryArena.h>
+
+int32_t LVScreenCache::s_budget = LV_SCREEN_CACHE_BUDGET;
+uint32_t LVScreenCache::s_slice = LV_SCREEN_PRELOAD_SLICE;
+
+void LVScreenCache::preload(LVScreen *screen)
+{
+    if(screen == nullptr || screen->isInited() || screen->isVisible())
+        return;
+
+    LVVector<LVScreen *> & queue = preloadQueue();
+    for (uint32_t i = 0; i < queue.size(); ++i)
+    {
+        if(queue[i] == screen)
+            return;
+    }
+
+    //可能在其他屏幕的初始化中调用,列表不进入屏幕内存区
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    queue.push_back(screen);
+    LVTask * task = preloadTask();
+    LVMemoryArena::resume(arena);
+
+    if(!task->isRunning())
+        task->start();
+}
+
+void LVScreenCache::cancelPreload(LVScreen *screen)
+{
+    removeFrom(preloadQueue(),screen);
+}
+
+void LVScreenCache::retain(LVScreen *screen)
+{
+    if(screen == nullptr || !screen->isInited())
+        return;
+
+    LVVector<LVScreen *> & list = cacheList();
+    removeFrom(list,screen);
+
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    list.push_back(screen);
+    LVMemoryArena::resume(arena);
+
+    trim();
+}
+
+void LVScreenCache::remove(LVScreen *screen)
+{
+    removeFrom(cacheList(),screen);
+    removeFrom(preloadQueue(),screen);
+}
+
+bool LVScreenCache::isCached(LVScreen *screen)
+{
+    LVVector<LVScreen *> & list = cacheList();
+    for (uint32_t i = 0; i < list.size(); ++i)
+    {
+        if(list[i] == screen)
+            return true;
+    }
+    return false;
+}
+
+uint32_t LVScreenCache::count()
+{
+    return cacheList().size();
+}
+
+bool LVScreenCache::evict()
+{
+    LVVector<LVScreen *> & list = cacheList();
+    if(list.empty())
+        return false;
+
+    LVScreen * screen = list[0];
+    list.erase(list.begin());
+    lvInfo("LVScreenCache evict [%s]",screen->name());
+    screen->cleanScreen();
+    return true;
+}
+
+void LVScreenCache::clear()
+{
+    while (evict());
+}
+
+bool LVScreenCache::trim()
+{
+    if(s_budget <= 0)
+        return true;
+
+    while (LVScreen::getUsedMemorySize() > s_budget)
+    {
+        if(!evict())
+            return false;
+    }
+    return true;
+}
+
+void LVScreenCache::setMemoryBudget(int32_t bytes)
+{
+    s_budget = bytes;
+    trim();
+}
+
+int32_t LVScreenCache::memoryBudget()
+{
+    return s_budget;
+}
+
+void LVScreenCache::setTimeSlice(uint32_t ms)
+{
+    s_slice = ms;
+}
+
+LVVector<LVScreen *> &LVScreenCache::cacheList()
+{
+    static LVVector<LVScreen *> s_cacheList;
+    return s_cacheList;
+}
+
+LVVector<LVScreen *> &LVScreenCache::preloadQueue()
+{
+    static LVVector<LVScreen *> s_preloadQueue;
+    return s_preloadQueue;
+}
+
+bool LVScreenCache::removeFrom(LVVector<LVScreen *> &list, LVScreen *screen)
+{
+    for (uint32_t i = 0; i < list.size(); ++i)
+    {
+        if(list[i] == screen)
+        {
+            list.erase(list.begin() + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+LVTask *LVScreenCache::preloadTask()
+{
+    static LVTask * s_task = nullptr;
+    if(s_task == nullptr)
+    {
+        //全局任务不进入屏幕内存区
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        s_task = new LVTask(preloadStep,LV_SCREEN_PRELOAD_PERIOD,LVTask::PRIO_LOWEST);
+        LVMemoryArena::resume(arena);
+    }
+    return s_task;
+}
+
+void LVScreenCache::preloadStep(LVTask *task)
+{
+    LVVector<LVScreen *> & queue = preloadQueue();
+    if(queue.empty())
+    {
+        task->stop();
+        task->setPeriod(LV_SCREEN_PRELOAD_PERIOD);
+        return;
+    }
+
+    //内存紧张时先清理缓存,仍然不够就退避等待,不在每个周期都重试
+    if(!trim())
+    {
+        uint32_t period = task->period * 2;
+        task->setPeriod(period < LV_SCREEN_PRELOAD_MAX_PERIOD ? period : LV_SCREEN_PRELOAD_MAX_PERIOD);
+        return;
+    }
+    if(task->period != LV_SCREEN_PRELOAD_PERIOD)
+        task->setPeriod(LV_SCREEN_PRELOAD_PERIOD);
+
+    LVScreen * screen = queue[0];
+    if(screen->isInited() || screen->isVisible())
+    {
+        queue.erase(queue.begin());
+        return;
+    }
+
+    bool inited = screen->prepare(s_slice);
+    if(inited || !screen->isPreparing())
+    {
+        //完成或失败
+        queue.erase(queue.begin());
+        if(inited)
+            retain(screen);
+    }
+}
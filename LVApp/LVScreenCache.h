@@ -0,0 +1,153 @@
+#ifndef LVSCREENCACHE_H
+#define LVSCREENCACHE_H
+
+#include <LVMisc/LVTask.h>
+#include <LVMisc/lvvector.h>
+
+/**
+ * 预加载每次占用的时间(毫秒),在步骤之间检查
+ */
+#ifndef LV_SCREEN_PRELOAD_SLICE
+#define LV_SCREEN_PRELOAD_SLICE 5
+#endif
+
+/**
+ * 预加载任务的周期(毫秒)
+ */
+#ifndef LV_SCREEN_PRELOAD_PERIOD
+#define LV_SCREEN_PRELOAD_PERIOD LV_DISP_DEF_REFR_PERIOD
+#endif
+
+/**
+ * 内存不足无法预加载时,任务周期逐次加倍,最长不超过这个值(毫秒)
+ */
+#ifndef LV_SCREEN_PRELOAD_MAX_PERIOD
+#define LV_SCREEN_PRELOAD_MAX_PERIOD 1000
+#endif
+
+/**
+ * 屏幕缓存的默认内存预算,getUsedMemorySize() 超过时清理缓存的屏幕,0表示不限制
+ */
+#ifndef LV_SCREEN_CACHE_BUDGET
+#if LV_MEM_CUSTOM == 0 && defined(LV_MEM_SIZE)
+#define LV_SCREEN_CACHE_BUDGET (LV_MEM_SIZE / 4 * 3)
+#else
+#define LV_SCREEN_CACHE_BUDGET 0
+#endif
+#endif
+
+class LVScreen;
+
+/**
+ * @brief 屏幕预加载和缓存
+ * 预加载:即将显示的屏幕在最低优先级的任务中分步初始化(LVScreen::setupScreenStep),
+ * 每次只占用一小段时间,不会造成卡顿;显示时剩余的步骤一次完成.
+ *
+ * 缓存:已初始化但隐藏的屏幕(预加载完成的,或者 setKeepWarm() 后隐藏的)按最近使用排列,
+ * 已用内存超过预算时清理最久未用的屏幕;清理后仍然超出预算时暂停预加载.
+ *
+ * 例子:
+ * settings->setKeepWarm();
+ * LVScreenCache::preload(settings);
+ * ...
+ * settings->show(this); //不需要再初始化
+ */
+class LVScreenCache
+{
+public:
+    /**
+     * @brief 预加载屏幕
+     * @param screen
+     */
+    static void preload(LVScreen * screen);
+
+    /**
+     * @brief 取消预加载,已完成的步骤保留
+     * @param screen
+     */
+    static void cancelPreload(LVScreen * screen);
+
+    /**
+     * @brief 隐藏的屏幕加入缓存,成为最近使用的
+     * @param screen 未初始化的屏幕不加入
+     */
+    static void retain(LVScreen * screen);
+
+    /**
+     * @brief 从缓存和预加载队列中移除(屏幕显示或删除时)
+     * @param screen
+     */
+    static void remove(LVScreen * screen);
+
+    /**
+     * @brief 屏幕是否在缓存中
+     * @param screen
+     * @return
+     */
+    static bool isCached(LVScreen * screen);
+
+    /**
+     * @brief 缓存的屏幕数量
+     * @return
+     */
+    static uint32_t count();
+
+    /**
+     * @brief 清理最久未用的屏幕
+     * @return 缓存为空时返回false
+     */
+    static bool evict();
+
+    /**
+     * @brief 清理所有缓存的屏幕
+     */
+    static void clear();
+
+    /**
+     * @brief 超出预算时清理最久未用的屏幕
+     * @return 是否在预算内
+     */
+    static bool trim();
+
+    /**
+     * @brief 内存预算
+     * @param bytes getUsedMemorySize() 的上限,0表示不限制
+     */
+    static void setMemoryBudget(int32_t bytes);
+    static int32_t memoryBudget();
+
+    /**
+     * @brief 预加载每次占用的时间
+     * @param ms
+     */
+    static void setTimeSlice(uint32_t ms);
+
+protected:
+    static int32_t s_budget;  //!< 内存预算
+    static uint32_t s_slice;  //!< 预加载时间片
+
+    /**
+     * @brief 缓存的屏幕,最久未用的在前
+     */
+    static LVVector<LVScreen *> & cacheList();
+
+    /**
+     * @brief 等待预加载的屏幕
+     */
+    static LVVector<LVScreen *> & preloadQueue();
+
+    static bool removeFrom(LVVector<LVScreen *> & list,LVScreen * screen);
+
+    /**
+     * @brief 预加载任务
+     */
+    static LVTask * preloadTask();
+
+    static void preloadStep(LVTask * task);
+
+private:
+    LVScreenCache() = delete;
+    ~LVScreenCache() = delete;
+};
+
+#endif // LVSCREENCACHE_H
@@ -0,0 +1,265 @@
+#include "LVScreenScript.h"
+
+#if LV_USE_SCREEN_SCRIPT
+
+#include <LVMisc/LVMemoryArena.h>
+#include <lv_hal/lv_hal_tick.h>
+
+LVScreenScript * LVScreenScript::s_first = nullptr;
+uint32_t LVScreenScript::s_nextId = 0;
+uint32_t LVScreenScript::s_round = 0;
+
+bool LVScriptWait::await_ready() const
+{
+#if LV_USE_ANIMATION
+    //动画已经结束,不需要挂起
+    if(m_type == WAIT_ANIM)
+        return !LVAnimation::isRunning(static_cast<const lv_anim_t*>(m_target),m_time);
+#endif
+    return false;
+}
+
+void *LVScriptWait::await_resume() const
+{
+    return m_script && m_type == WAIT_SIGNAL ? m_script->m_signalParam : nullptr;
+}
+
+LVScreenScript::LVScreenScript(LVScreen *screen, LVScript::Handle handle)
+    : m_handle(handle)
+    , m_screen(screen)
+    , m_round(s_round)
+    , m_slot([this](LVSignal * signal){ onSignal(signal); })
+{
+    if(++s_nextId == 0)
+        ++s_nextId;
+    m_id = s_nextId;
+    m_handle.promise().m_script = this;
+
+    m_next = s_first;
+    if(s_first)
+        s_first->m_prev = this;
+    s_first = this;
+}
+
+LVScreenScript::~LVScreenScript()
+{
+    if(m_prev)
+        m_prev->m_next = m_next;
+    else
+        s_first = m_next;
+    if(m_next)
+        m_next->m_prev = m_prev;
+
+    //协程已挂起,局部对象随协程帧一起析构
+    m_handle.promise().m_script = nullptr;
+    m_handle.destroy();
+}
+
+uint32_t LVScreenScript::run(LVScreen *screen, LVScript script)
+{
+    if(!script.m_handle)
+        return 0;
+
+    LVScreenScript * s = new LVScreenScript(screen,script.m_handle);
+    script.m_handle = nullptr;
+    schedule();
+    return s->m_id;
+}
+
+bool LVScreenScript::cancel(uint32_t id)
+{
+    for (LVScreenScript * s = s_first; s; s = s->m_next)
+    {
+        if(s->m_id == id)
+        {
+            s->cancel();
+            return true;
+        }
+    }
+    return false;
+}
+
+void LVScreenScript::cancelScreen(LVScreen *screen)
+{
+    LVScreenScript * s = s_first;
+    while (s)
+    {
+        //取消只会删除自己,先取出下一个
+        LVScreenScript * next = s->m_next;
+        if(s->m_screen == screen)
+            s->cancel();
+        s = next;
+    }
+}
+
+uint32_t LVScreenScript::count()
+{
+    uint32_t n = 0;
+    for (LVScreenScript * s = s_first; s; s = s->m_next)
+        ++n;
+    return n;
+}
+
+void LVScreenScript::wait(const LVScriptWait &wait)
+{
+    m_waitType = wait.m_type;
+    switch (m_waitType)
+    {
+    case LVScriptWait::WAIT_TIME:
+        m_waitUntil = lv_tick_get() + wait.m_time;
+        break;
+    case LVScriptWait::WAIT_FRAME:
+        m_waitUntil = lv_tick_get() + LV_SCREEN_SCRIPT_FRAME_PERIOD;
+        break;
+    case LVScriptWait::WAIT_ANIM:
+        m_waitAnim = static_cast<const lv_anim_t*>(wait.m_target);
+        m_waitSerial = wait.m_time;
+        break;
+    case LVScriptWait::WAIT_SIGNAL:
+        m_signalParam = nullptr;
+        m_slot.connect(static_cast<LVSignal*>(wait.m_target));
+        break;
+    default:
+        break;
+    }
+}
+
+bool LVScreenScript::isDue(uint32_t now) const
+{
+    switch (m_waitType)
+    {
+    case LVScriptWait::WAIT_TIME:
+    case LVScriptWait::WAIT_FRAME:
+        return (int32_t)(now - m_waitUntil) >= 0;
+    case LVScriptWait::WAIT_ANIM:
+#if LV_USE_ANIMATION
+        return !LVAnimation::isRunning(m_waitAnim,m_waitSerial);
+#else
+        return true;
+#endif
+    case LVScriptWait::WAIT_SIGNAL:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void LVScreenScript::resume()
+{
+    m_waitType = LVScriptWait::WAIT_NONE;
+    m_round = s_round;
+    m_resuming = true;
+    m_handle.resume();
+    m_resuming = false;
+
+    if(m_handle.done() || m_cancelled)
+        delete this;
+}
+
+void LVScreenScript::cancel()
+{
+    //协程正在运行(比如脚本中隐藏了所属屏幕),不能销毁协程帧
+    if(m_resuming)
+    {
+        m_cancelled = true;
+        m_slot.disConnectAll();
+    }
+    else
+    {
+        delete this;
+    }
+}
+
+void LVScreenScript::onSignal(LVSignal *signal)
+{
+    if(m_waitType != LVScriptWait::WAIT_SIGNAL)
+        return;
+
+    //只等待一次,槽函数中可以断开当前的连接
+    m_slot.disConnectAll();
+    m_signalParam = signal->param();
+    m_waitType = LVScriptWait::WAIT_NONE;
+    schedule();
+}
+
+LVTask *LVScreenScript::driver()
+{
+    static LVTask * s_driver = nullptr;
+    if(s_driver == nullptr)
+    {
+        //全局任务不进入屏幕内存区
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        s_driver = new LVTask(drive,LV_SCREEN_SCRIPT_FRAME_PERIOD,LVTask::PRIO_MID);
+        LVMemoryArena::resume(arena);
+    }
+    return s_driver;
+}
+
+void LVScreenScript::drive(LVTask * /*task*/)
+{
+    ++s_round;
+    uint32_t now = lv_tick_get();
+    LVScreenScript * s = s_first;
+    while (s)
+    {
+        if(s->m_round == s_round || !s->isDue(now))
+        {
+            s = s->m_next;
+            continue;
+        }
+
+        s->resume();
+        //脚本中可能运行或取消了其他脚本,从头开始,本轮已运行的被跳过
+        s = s_first;
+    }
+    schedule();
+}
+
+void LVScreenScript::schedule()
+{
+    uint32_t now = lv_tick_get();
+    uint32_t period = LV_TASK_NO_DEADLINE;
+    for (LVScreenScript * s = s_first; s && period; s = s->m_next)
+    {
+        switch (s->m_waitType)
+        {
+        case LVScriptWait::WAIT_NONE:
+            period = 0;
+            break;
+        case LVScriptWait::WAIT_TIME:
+        case LVScriptWait::WAIT_FRAME:
+        {
+            int32_t remain = (int32_t)(s->m_waitUntil - now);
+            if(remain <= 0)
+                period = 0;
+            else if((uint32_t)remain < period)
+                period = remain;
+            break;
+        }
+        case LVScriptWait::WAIT_ANIM:
+            if(period > LV_SCREEN_SCRIPT_FRAME_PERIOD)
+                period = LV_SCREEN_SCRIPT_FRAME_PERIOD;
+            break;
+        default:
+            break;
+        }
+    }
+
+    //只剩等待信号的脚本时停止任务,由信号重新开始
+    LVTask * task = driver();
+    if(period == LV_TASK_NO_DEADLINE)
+    {
+        if(task->isRunning())
+            task->stop();
+    }
+    else
+    {
+        task->setPeriod(period);
+        if(task->isRunning())
+            task->reset();
+        else
+            task->start();
+    }
+}
+
+#endif // LV_USE_SCREEN_SCRIPT
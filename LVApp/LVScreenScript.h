@@ -0,0 +1,298 @@
+#ifndef LVSCREENSCRIPT_H
+#define LVSCREENSCRIPT_H
+
+#include <LVMisc/LVTask.h>
+#include <LVMisc/LVMemory.h>
+#include <LVCore/LVSignalSlot.h>
+#include <lv_misc/lv_anim.h>
+
+/**
+ * 使用协程编写屏幕脚本,需要支持C++20协程的编译器
+ */
+#ifndef LV_USE_SCREEN_SCRIPT
+#if defined(__cpp_impl_coroutine)
+#define LV_USE_SCREEN_SCRIPT 1
+#else
+#define LV_USE_SCREEN_SCRIPT 0
+#endif
+#endif
+
+/**
+ * 等待下一帧或等待动画结束时的检查周期(毫秒)
+ */
+#ifndef LV_SCREEN_SCRIPT_FRAME_PERIOD
+#define LV_SCREEN_SCRIPT_FRAME_PERIOD LV_DISP_DEF_REFR_PERIOD
+#endif
+
+#if LV_USE_SCREEN_SCRIPT
+
+#include <coroutine>
+#if LV_USE_ANIMATION
+#include <LVMisc/LVAnimation.h>
+#endif
+
+class LVScreen;
+class LVScreenScript;
+
+/**
+ * @brief 脚本中 co_await 的等待对象
+ * 等待的状态保存在 LVScreenScript 中,不申请内存
+ */
+class LVScriptWait
+{
+    friend class LVScreenScript;
+public:
+    enum Type : uint8_t
+    {
+        WAIT_NONE,   //!< 不等待
+        WAIT_TIME,   //!< 等待一段时间
+        WAIT_FRAME,  //!< 等待下一帧
+        WAIT_ANIM,   //!< 等待动画结束
+        WAIT_SIGNAL, //!< 等待信号发出
+    };
+
+protected:
+    Type m_type;
+    uint32_t m_time;
+    void * m_target;
+    LVScreenScript * m_script = nullptr;
+
+public:
+    LVScriptWait(Type type,uint32_t time = 0,void * target = nullptr)
+        : m_type(type)
+        , m_time(time)
+        , m_target(target)
+    {}
+
+    bool await_ready() const;
+
+    template<class Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle);
+
+    /**
+     * @brief 等待信号时返回信号的参数
+     * @return
+     */
+    void * await_resume() const;
+};
+
+/**
+ * @brief co_await sleepFor(ms) 等待一段时间
+ */
+struct LVScriptSleep
+{
+    uint32_t ms;
+};
+
+/**
+ * @brief co_await nextFrame() 等待下一帧
+ */
+struct LVScriptFrame
+{};
+
+inline LVScriptSleep sleepFor(uint32_t ms) { return LVScriptSleep{ms}; }
+inline LVScriptFrame nextFrame() { return LVScriptFrame{}; }
+
+/**
+ * @brief 屏幕脚本的协程
+ * 作为协程函数的返回类型,交给 LVScreenScript::run() 运行
+ */
+class LVScript
+{
+public:
+    struct promise_type
+    {
+        LVScreenScript * m_script = nullptr; //!< 运行协程的脚本,脚本取消后为nullptr
+
+        //协程帧交由LVGL管理内存,不能使用LV_MEMORY中的placement new
+        static void * operator new(size_t size) { return LVMemory::allocate(size); }
+        static void operator delete(void * p) { LVMemory::free(p); }
+
+        LVScript get_return_object() { return LVScript(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        //创建后先挂起,由 LVScreenScript 的任务开始运行
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        //结束后挂起,由 LVScreenScript 销毁
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+
+        LVScriptWait await_transform(LVScriptSleep sleep) { return LVScriptWait(LVScriptWait::WAIT_TIME,sleep.ms); }
+        LVScriptWait await_transform(LVScriptFrame) { return LVScriptWait(LVScriptWait::WAIT_FRAME); }
+        LVScriptWait await_transform(LVSignal & signal) { return LVScriptWait(LVScriptWait::WAIT_SIGNAL,0,&signal); }
+        LVScriptWait await_transform(LVSignal * signal) { return LVScriptWait(LVScriptWait::WAIT_SIGNAL,0,signal); }
+#if LV_USE_ANIMATION
+        //记录序号,动画的内存被重用后不会误认
+        LVScriptWait await_transform(LVAnimation & anim) { return LVScriptWait(LVScriptWait::WAIT_ANIM,anim.serial(),static_cast<lv_anim_t*>(&anim)); }
+        LVScriptWait await_transform(LVAnimation * anim) { return LVScriptWait(LVScriptWait::WAIT_ANIM,anim->serial(),static_cast<lv_anim_t*>(anim)); }
+#endif
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    LVScript(LVScript && other)
+        : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+
+    ~LVScript()
+    {
+        //没有交给 LVScreenScript 运行
+        if(m_handle)
+            m_handle.destroy();
+    }
+
+protected:
+    friend class LVScreenScript;
+    Handle m_handle;
+
+    explicit LVScript(Handle handle)
+        : m_handle(handle)
+    {}
+
+private:
+    LVScript(const LVScript&) = delete;
+    LVScript& operator = (const LVScript&) = delete;
+};
+
+/**
+ * @brief 协程写成的屏幕脚本
+ * 把多步骤的界面流程写成顺序的代码,代替层层嵌套的 LVTask::once 和动画回调:
+ *
+ * LVScript MyScreen::intro()
+ * {
+ *     showBubble("Hello");
+ *     co_await sleepFor(3000);
+ *     co_await *m_fadeAnim;              //等待动画结束
+ *     void * p = co_await m_confirmed;   //等待 LVSignal,返回信号参数
+ *     co_await nextFrame();
+ * }
+ * LVScreenScript::run(this,intro());
+ *
+ * 所有脚本由同一个 LVTask 恢复运行,任务周期按最近的等待自动调整,
+ * 只等待信号时任务停止.除了协程帧,每一步都不申请内存.
+ * 所属屏幕隐藏时脚本自动取消,协程中的局部对象正常析构.
+ *
+ * NOTE: 协程函数的参数按值保存在协程帧中,
+ *       拉姆达的捕获在拉姆达对象析构后失效,应使用成员函数或参数传递
+ */
+class LVScreenScript
+{
+    LV_MEMORY
+
+    friend class LVScriptWait;
+protected:
+    LVScript::Handle m_handle;           //!< 协程
+    LVScreen * m_screen;                 //!< 所属的屏幕
+    uint32_t m_id;                       //!< 取消用的编号
+    uint32_t m_round;                    //!< 最近一次恢复运行的轮次
+    LVScriptWait::Type m_waitType = LVScriptWait::WAIT_NONE; //!< 正在等待的类型
+    bool m_resuming = false;             //!< 正在运行协程
+    bool m_cancelled = false;            //!< 运行中被取消,挂起后删除
+    uint32_t m_waitUntil = 0;            //!< 等待时间的结束时钟
+    const lv_anim_t * m_waitAnim = nullptr; //!< 等待的动画,不访问其内容
+    uint32_t m_waitSerial = 0;           //!< 等待的动画的创建序号
+    void * m_signalParam = nullptr;      //!< 等待到的信号参数
+    LVSlot m_slot;                       //!< 等待信号的槽
+    LVScreenScript * m_prev = nullptr;
+    LVScreenScript * m_next = nullptr;
+
+    static LVScreenScript * s_first;
+    static uint32_t s_nextId;
+    static uint32_t s_round;
+
+    LVScreenScript(LVScreen * screen,LVScript::Handle handle);
+    ~LVScreenScript();
+
+public:
+    /**
+     * @brief 运行屏幕脚本
+     * 在下一次任务处理时开始运行
+     * @param screen 所属的屏幕,隐藏时取消脚本,nullptr表示不随屏幕取消
+     * @param script 协程函数的返回值
+     * @return 用于 cancel() 的编号
+     */
+    static uint32_t run(LVScreen * screen,LVScript script);
+
+    /**
+     * @brief 取消脚本
+     * @param id run() 的返回值
+     * @return 是否找到
+     */
+    static bool cancel(uint32_t id);
+
+    /**
+     * @brief 取消屏幕的所有脚本
+     * @param screen
+     */
+    static void cancelScreen(LVScreen * screen);
+
+    /**
+     * @brief 正在运行的脚本数量
+     * @return
+     */
+    static uint32_t count();
+
+protected:
+    /**
+     * @brief 协程挂起时记录等待的条件
+     * @param wait
+     */
+    void wait(const LVScriptWait & wait);
+
+    /**
+     * @brief 等待的条件是否满足
+     * @param now
+     * @return
+     */
+    bool isDue(uint32_t now) const;
+
+    /**
+     * @brief 恢复协程,结束或取消后删除脚本
+     */
+    void resume();
+
+    /**
+     * @brief 取消脚本,运行中时等协程挂起后再删除
+     */
+    void cancel();
+
+    /**
+     * @brief 等待的信号发出
+     * @param signal
+     */
+    void onSignal(LVSignal * signal);
+
+    /**
+     * @brief 运行所有脚本的任务
+     * @return
+     */
+    static LVTask * driver();
+
+    /**
+     * @brief 任务函数,恢复所有等待结束的脚本
+     * @param task
+     */
+    static void drive(LVTask * task);
+
+    /**
+     * @brief 按最近的等待调整任务周期
+     */
+    static void schedule();
+
+private:
+    LVScreenScript(const LVScreenScript&) = delete;
+    LVScreenScript& operator = (const LVScreenScript&) = delete;
+};
+
+template<class Promise>
+bool LVScriptWait::await_suspend(std::coroutine_handle<Promise> handle)
+{
+    m_script = handle.promise().m_script;
+    if(m_script)
+        m_script->wait(*this);
+    return true;
+}
+
+#endif // LV_USE_SCREEN_SCRIPT
+
+#endif // LVSCREENSCRIPT_H
@@ -0,0 +1,114 @@
+#include "LVScreenStack.h"
+#include "LVScreen.h"
+#include <LVMisc/LVMemoryArena.h>
+
+bool LVScreenStack::push(LVScreen *screen)
+{
+    if(screen == nullptr)
+        return false;
+
+    LVScreen * curr = LVScreen::currScreen();
+    if(curr == screen)
+        return true;
+
+    //先入栈,隐藏清理时才会保存状态
+    bool pushed = false;
+    if(curr && !curr->isDeleteAfterHide())
+    {
+        remove(curr);
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        stack().push_back(curr);
+        LVMemoryArena::resume(arena);
+        pushed = true;
+    }
+
+    if(!screen->show(curr))
+    {
+        if(pushed)
+            remove(curr);
+        return false;
+    }
+
+    //显示的屏幕不在栈中
+    remove(screen);
+    return true;
+}
+
+bool LVScreenStack::pop()
+{
+    LVScreen * screen = top();
+    if(screen == nullptr)
+        return false;
+
+    stack().pop_back();
+    if(!screen->show())
+    {
+        //显示失败时放回栈中
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        stack().push_back(screen);
+        LVMemoryArena::resume(arena);
+        return false;
+    }
+    return true;
+}
+
+bool LVScreenStack::popTo(LVScreen *screen)
+{
+    if(!contains(screen))
+        return false;
+
+    //中间的屏幕不会再返回,与 pop() 显示后一样释放保存的状态
+    LVVector<LVScreen *> & list = stack();
+    while (list.back() != screen)
+    {
+        list.back()->clearState();
+        list.pop_back();
+    }
+    return pop();
+}
+
+LVScreen *LVScreenStack::top()
+{
+    LVVector<LVScreen *> & list = stack();
+    return list.empty() ? nullptr : list.back();
+}
+
+uint32_t LVScreenStack::depth()
+{
+    return stack().size();
+}
+
+bool LVScreenStack::contains(LVScreen *screen)
+{
+    LVVector<LVScreen *> & list = stack();
+    for (uint32_t i = 0; i < list.size(); ++i)
+    {
+        if(list[i] == screen)
+            return true;
+    }
+    return false;
+}
+
+void LVScreenStack::remove(LVScreen *screen)
+{
+    LVVector<LVScreen *> & list = stack();
+    for (uint32_t i = 0; i < list.size(); ++i)
+    {
+        if(list[i] == screen)
+        {
+            list.erase(list.begin() + i);
+            return;
+        }
+    }
+}
+
+void LVScreenStack::clear()
+{
+    stack().clear();
+}
+
+LVVector<LVScreen *> &LVScreenStack::stack()
+{
+    static LVVector<LVScreen *> s_stack;
+    return s_stack;
+}
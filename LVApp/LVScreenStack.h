@@ -0,0 +1,81 @@
+#ifndef LVSCREENSTACK_H
+#define LVSCREENSTACK_H
+
+#include <LVMisc/lvvector.h>
+
+class LVScreen;
+
+/**
+ * @brief 屏幕导航栈
+ * push() 显示新屏幕,之前的屏幕入栈;pop() 返回栈顶的屏幕.
+ * 栈中的屏幕隐藏后照常清理(不占用控件的内存),清理时保存控件状态(LVScreenState),
+ * 返回时重新初始化并恢复滚动位置,选中项和输入的内容.
+ *
+ * 例子:
+ * LVScreenStack::push(settings);
+ * ...
+ * LVScreenStack::pop(); //返回之前的屏幕
+ */
+class LVScreenStack
+{
+public:
+    /**
+     * @brief 显示屏幕,当前屏幕入栈
+     * 隐藏后删除的屏幕不入栈
+     * @param screen
+     * @return 是否显示成功
+     */
+    static bool push(LVScreen * screen);
+
+    /**
+     * @brief 返回栈顶的屏幕
+     * @return 栈为空或显示失败时返回false
+     */
+    static bool pop();
+
+    /**
+     * @brief 返回到指定的屏幕,中间的屏幕出栈并丢弃保存的状态
+     * @param screen
+     * @return 屏幕不在栈中或显示失败时返回false
+     */
+    static bool popTo(LVScreen * screen);
+
+    /**
+     * @brief 栈顶的屏幕
+     * @return 栈为空时返回nullptr
+     */
+    static LVScreen * top();
+
+    /**
+     * @brief 栈的深度
+     * @return
+     */
+    static uint32_t depth();
+
+    /**
+     * @brief 屏幕是否在栈中
+     * @param screen
+     * @return
+     */
+    static bool contains(LVScreen * screen);
+
+    /**
+     * @brief 从栈中移除屏幕(屏幕删除时)
+     * @param screen
+     */
+    static void remove(LVScreen * screen);
+
+    /**
+     * @brief 清空栈,不清理屏幕
+     */
+    static void clear();
+
+protected:
+    static LVVector<LVScreen *> & stack();
+
+private:
+    LVScreenStack() = delete;
+    ~LVScreenStack() = delete;
+};
+
+#endif // LVSCREENSTACK_H
@@ -0,0 +1,374 @@
+#include "LVScreenState.h"
+#include <LVMisc/LVMemoryArena.h>
+#include <lvgl.h>
+#include <string.h>
+
+void LVScreenState::clear()
+{
+    if(m_data)
+    {
+        LVMemory::free(m_data);
+        m_data = nullptr;
+    }
+    m_size = 0;
+    m_capacity = 0;
+    m_pos = 0;
+    m_error = false;
+}
+
+bool LVScreenState::reserve(uint32_t size)
+{
+    if(m_error)
+        return false;
+    if(m_size + size <= m_capacity)
+        return true;
+
+    uint32_t capacity = m_capacity ? m_capacity * 2 : 32;
+    while (capacity < m_size + size)
+        capacity *= 2;
+
+    //状态比屏幕的内容活得长,不进入屏幕内存区
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    uint8_t * data = static_cast<uint8_t *>(LVMemory::reallocate(m_data,capacity));
+    LVMemoryArena::resume(arena);
+    if(data == nullptr)
+    {
+        lvWarn("LVScreenState no memory");
+        m_error = true;
+        return false;
+    }
+
+    m_data = data;
+    m_capacity = capacity;
+    return true;
+}
+
+void LVScreenState::writeByte(uint8_t value)
+{
+    if(reserve(1))
+        m_data[m_size++] = value;
+}
+
+void LVScreenState::writeTag(uint8_t tag)
+{
+    writeByte(tag);
+}
+
+void LVScreenState::writeInt(int32_t value)
+{
+    //zigzag 编码,绝对值小的数只占一个字节
+    uint32_t v = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    while (v >= 0x80)
+    {
+        writeByte((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    writeByte((uint8_t)v);
+}
+
+void LVScreenState::writeString(const char *str)
+{
+    uint32_t len = str ? strlen(str) : 0;
+    writeInt((int32_t)len);
+    //带结束符,读取时直接使用数据中的字符串
+    if(reserve(len + 1))
+    {
+        memcpy(m_data + m_size,str ? str : "",len);
+        m_data[m_size + len] = '\0';
+        m_size += len + 1;
+    }
+}
+
+void LVScreenState::finish()
+{
+    writeTag(TAG_END);
+    if(m_error)
+    {
+        clear();
+        return;
+    }
+
+    if(m_capacity > m_size)
+    {
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        uint8_t * data = static_cast<uint8_t *>(LVMemory::reallocate(m_data,m_size));
+        LVMemoryArena::resume(arena);
+        if(data)
+        {
+            m_data = data;
+            m_capacity = m_size;
+        }
+    }
+}
+
+uint8_t LVScreenState::readTag()
+{
+    if(m_pos >= m_size)
+    {
+        m_error = true;
+        return TAG_END;
+    }
+    return m_data[m_pos++];
+}
+
+uint32_t LVScreenState::readVarint()
+{
+    uint32_t v = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7)
+    {
+        if(m_pos >= m_size)
+            break;
+        uint8_t b = m_data[m_pos++];
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if((b & 0x80) == 0)
+            return v;
+    }
+    m_error = true;
+    return 0;
+}
+
+int32_t LVScreenState::readInt()
+{
+    uint32_t v = readVarint();
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+const char *LVScreenState::readString()
+{
+    uint32_t len = (uint32_t)readInt();
+    if(m_error || len >= m_size - m_pos)
+    {
+        m_error = true;
+        return "";
+    }
+    const char * str = reinterpret_cast<const char *>(m_data + m_pos);
+    m_pos += len + 1;
+    return str;
+}
+
+bool LVScreenState::expect(uint8_t tag)
+{
+    if(readTag() != tag)
+        m_error = true;
+    return !m_error;
+}
+
+/**
+ * 有状态的控件对应的标签,其他对象返回 TAG_END
+ */
+static uint8_t objectTag(lv_obj_t * obj)
+{
+    lv_obj_type_t type;
+    lv_obj_get_type(obj,&type);
+    const char * name = type.type[0];
+    if(name == nullptr || strncmp(name,"lv_",3) != 0)
+        return LVScreenState::TAG_END;
+    name += 3;
+
+#if LV_USE_PAGE
+    if(strcmp(name,"page") == 0 || strcmp(name,"list") == 0)
+        return LVScreenState::TAG_PAGE;
+#endif
+#if LV_USE_TA
+    if(strcmp(name,"ta") == 0)
+        return LVScreenState::TAG_TEXTAREA;
+#endif
+#if LV_USE_DDLIST
+    if(strcmp(name,"ddlist") == 0)
+        return LVScreenState::TAG_DDLIST;
+#endif
+#if LV_USE_ROLLER
+    if(strcmp(name,"roller") == 0)
+        return LVScreenState::TAG_ROLLER;
+#endif
+#if LV_USE_TABVIEW
+    if(strcmp(name,"tabview") == 0)
+        return LVScreenState::TAG_TABVIEW;
+#endif
+#if LV_USE_BTN
+    //普通按钮没有需要保存的状态
+    if(strcmp(name,"btn") == 0 && lv_btn_get_toggle(obj))
+        return LVScreenState::TAG_BUTTON;
+#endif
+#if LV_USE_CB
+    if(strcmp(name,"cb") == 0)
+        return LVScreenState::TAG_CHECKBOX;
+#endif
+#if LV_USE_SW
+    if(strcmp(name,"sw") == 0)
+        return LVScreenState::TAG_SWITCH;
+#endif
+#if LV_USE_SLIDER
+    if(strcmp(name,"slider") == 0)
+        return LVScreenState::TAG_SLIDER;
+#endif
+    return LVScreenState::TAG_END;
+}
+
+void LVScreenState::saveChildren(lv_obj_t *parent)
+{
+    for (lv_obj_t * child = lv_obj_get_child(parent,nullptr); child; child = lv_obj_get_child(parent,child))
+        saveObject(child);
+}
+
+bool LVScreenState::restoreChildren(lv_obj_t *parent)
+{
+    for (lv_obj_t * child = lv_obj_get_child(parent,nullptr); child; child = lv_obj_get_child(parent,child))
+    {
+        if(!restoreObject(child))
+            return false;
+    }
+    return true;
+}
+
+void LVScreenState::saveObject(lv_obj_t *obj)
+{
+    uint8_t tag = objectTag(obj);
+    if(tag != TAG_END)
+        writeTag(tag);
+
+    switch (tag)
+    {
+#if LV_USE_PAGE
+    case TAG_PAGE:
+    {
+        lv_obj_t * scrl = lv_page_get_scrl(obj);
+        writeInt(lv_obj_get_x(scrl));
+        writeInt(lv_obj_get_y(scrl));
+        break;
+    }
+#endif
+#if LV_USE_TA
+    case TAG_TEXTAREA:
+        //不保存密码
+        if(lv_ta_get_pwd_mode(obj))
+        {
+            writeString(nullptr);
+            writeInt(-1);
+        }
+        else
+        {
+            writeString(lv_ta_get_text(obj));
+            writeInt(lv_ta_get_cursor_pos(obj));
+        }
+        break;
+#endif
+#if LV_USE_DDLIST
+    case TAG_DDLIST:
+        writeInt(lv_ddlist_get_selected(obj));
+        break;
+#endif
+#if LV_USE_ROLLER
+    case TAG_ROLLER:
+        writeInt(lv_roller_get_selected(obj));
+        break;
+#endif
+#if LV_USE_TABVIEW
+    case TAG_TABVIEW:
+        writeInt(lv_tabview_get_tab_act(obj));
+        break;
+#endif
+#if LV_USE_BTN
+    case TAG_BUTTON:
+        writeInt(lv_btn_get_state(obj));
+        break;
+#endif
+#if LV_USE_CB
+    case TAG_CHECKBOX:
+        writeInt(lv_cb_is_checked(obj));
+        break;
+#endif
+#if LV_USE_SW
+    case TAG_SWITCH:
+        writeInt(lv_sw_get_state(obj));
+        break;
+#endif
+#if LV_USE_SLIDER
+    case TAG_SLIDER:
+        writeInt(lv_slider_get_value(obj));
+        break;
+#endif
+    default:
+        break;
+    }
+
+    saveChildren(obj);
+}
+
+bool LVScreenState::restoreObject(lv_obj_t *obj)
+{
+    uint8_t tag = objectTag(obj);
+    if(tag != TAG_END && !expect(tag))
+        return false;
+
+    switch (tag)
+    {
+#if LV_USE_PAGE
+    case TAG_PAGE:
+    {
+        lv_coord_t x = (lv_coord_t)readInt();
+        lv_coord_t y = (lv_coord_t)readInt();
+        lv_obj_set_pos(lv_page_get_scrl(obj),x,y);
+        break;
+    }
+#endif
+#if LV_USE_TA
+    case TAG_TEXTAREA:
+    {
+        const char * text = readString();
+        int32_t cursor = readInt();
+        if(cursor >= 0)
+        {
+            lv_ta_set_text(obj,text);
+            lv_ta_set_cursor_pos(obj,cursor);
+        }
+        break;
+    }
+#endif
+#if LV_USE_DDLIST
+    case TAG_DDLIST:
+        lv_ddlist_set_selected(obj,(uint16_t)readInt());
+        break;
+#endif
+#if LV_USE_ROLLER
+    case TAG_ROLLER:
+        lv_roller_set_selected(obj,(uint16_t)readInt(),LV_ANIM_OFF);
+        break;
+#endif
+#if LV_USE_TABVIEW
+    case TAG_TABVIEW:
+        lv_tabview_set_tab_act(obj,(uint16_t)readInt(),LV_ANIM_OFF);
+        break;
+#endif
+#if LV_USE_BTN
+    case TAG_BUTTON:
+        lv_btn_set_state(obj,(lv_btn_state_t)readInt());
+        break;
+#endif
+#if LV_USE_CB
+    case TAG_CHECKBOX:
+        lv_cb_set_checked(obj,readInt() != 0);
+        break;
+#endif
+#if LV_USE_SW
+    case TAG_SWITCH:
+        if(readInt())
+            lv_sw_on(obj,LV_ANIM_OFF);
+        else
+            lv_sw_off(obj,LV_ANIM_OFF);
+        break;
+#endif
+#if LV_USE_SLIDER
+    case TAG_SLIDER:
+        lv_slider_set_value(obj,(int16_t)readInt(),LV_ANIM_OFF);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    if(m_error)
+        return false;
+
+    return restoreChildren(obj);
+}
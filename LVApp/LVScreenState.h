@@ -0,0 +1,144 @@
+#ifndef LVSCREENSTATE_H
+#define LVSCREENSTATE_H
+
+#include <LVMisc/LVMemory.h>
+#include <lv_core/lv_obj.h>
+
+/**
+ * @brief 屏幕状态
+ * 屏幕清理时保存控件的状态(滚动位置,选中项,输入框内容等),重新初始化后恢复,
+ * 屏幕可以随时清理,返回时不会丢失用户看到的内容.
+ *
+ * 数据紧凑地顺序存放:每项是一个标签字节加上变长编码的整数或字符串.
+ * 屏幕的控件树在重新初始化后结构相同,按同样的顺序遍历即可恢复;
+ * 标签不一致时说明结构变了,停止恢复.
+ *
+ * 子类可以在 LVScreen::saveState()/restoreState() 中写入自己的数据:
+ * void saveState(LVScreenState & state) override
+ * {
+ *     LVScreen::saveState(state);
+ *     state.writeTag(LVScreenState::TAG_USER);
+ *     state.writeInt(m_page);
+ * }
+ */
+class LVScreenState
+{
+    LV_MEMORY
+
+public:
+    /**
+     * @brief 数据项的标签
+     */
+    enum Tag : uint8_t
+    {
+        TAG_END,      //!< 结束
+        TAG_PAGE,     //!< 页面的滚动位置
+        TAG_TEXTAREA, //!< 输入框的内容和光标
+        TAG_DDLIST,   //!< 下拉列表的选中项
+        TAG_ROLLER,   //!< 滚轮的选中项
+        TAG_TABVIEW,  //!< 选项卡的当前页
+        TAG_BUTTON,   //!< 切换按钮的状态
+        TAG_CHECKBOX, //!< 复选框的状态
+        TAG_SWITCH,   //!< 开关的状态
+        TAG_SLIDER,   //!< 滑块的值
+        TAG_USER = 0x80, //!< 子类自定义的数据从这里开始
+    };
+
+    LVScreenState() {}
+    ~LVScreenState() { clear(); }
+
+    LVScreenState(const LVScreenState&) = delete;
+    LVScreenState& operator=(const LVScreenState&) = delete;
+
+    /**
+     * @brief 释放数据
+     */
+    void clear();
+
+    bool isEmpty() const { return m_size == 0; }
+
+    /**
+     * @brief 数据大小(字节)
+     * @return
+     */
+    uint32_t size() const { return m_size; }
+
+    /**
+     * @brief 写入或读取是否出错(内存不足或数据不完整)
+     * @return
+     */
+    bool hasError() const { return m_error; }
+
+    /*=====================
+     * 写入
+     *====================*/
+
+    void writeTag(uint8_t tag);
+    void writeInt(int32_t value);
+    void writeString(const char * str);
+
+    /**
+     * @brief 写入结束,释放多余的空间
+     */
+    void finish();
+
+    /*=====================
+     * 读取
+     *====================*/
+
+    /**
+     * @brief 从头开始读取
+     */
+    void rewind() { m_pos = 0; m_error = false; }
+
+    bool atEnd() const { return m_pos >= m_size; }
+
+    uint8_t readTag();
+    int32_t readInt();
+
+    /**
+     * @brief 读取字符串
+     * @return 指向数据内部的字符串,数据清除前有效
+     */
+    const char * readString();
+
+    /**
+     * @brief 读取标签并检查
+     * @param tag
+     * @return 标签不一致时返回false,并标记出错
+     */
+    bool expect(uint8_t tag);
+
+    /*=====================
+     * 控件树
+     *====================*/
+
+    /**
+     * @brief 按顺序保存对象的所有子对象的状态
+     * @param parent
+     */
+    void saveChildren(lv_obj_t * parent);
+
+    /**
+     * @brief 按保存时的顺序恢复子对象的状态
+     * @param parent
+     * @return 结构不一致时返回false
+     */
+    bool restoreChildren(lv_obj_t * parent);
+
+protected:
+    uint8_t * m_data = nullptr;
+    uint32_t m_size = 0;
+    uint32_t m_capacity = 0;
+    uint32_t m_pos = 0;
+    bool m_error = false;
+
+    bool reserve(uint32_t size);
+    void writeByte(uint8_t value);
+    uint32_t readVarint();
+
+    void saveObject(lv_obj_t * obj);
+    bool restoreObject(lv_obj_t * obj);
+};
+
+#endif // LVSCREENSTATE_H
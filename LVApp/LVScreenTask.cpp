@@ -22,7 +22,7 @@ void LVScreenTask::setScreen(LVScreen * screen)
     if(m_screen != screen)
     {
         //先注销
-        if(m_screen != nullptr && m_nodeId != nullptr)
+        if(m_screen != nullptr && m_taskIndex >= 0)
             m_screen->logoutTask(this);
 
         //再注册
@@ -48,15 +48,15 @@ void LVScreenTask::onScreenHide()
 
 void LVScreenTask::loginTask()
 {
-    if(m_screen != nullptr && m_nodeId == nullptr)
+    if(m_screen != nullptr && m_taskIndex < 0)
         m_screen->loginTask(this);
 }
 
 void LVScreenTask::logoutTask()
 {
-    if(m_screen != nullptr && m_nodeId != nullptr)
+    if(m_screen != nullptr && m_taskIndex >= 0)
     {
         m_screen->logoutTask(this);
-        m_nodeId = nullptr;
+        m_taskIndex = -1;
     }
 }
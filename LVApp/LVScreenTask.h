@@ -2,7 +2,6 @@
 #define LVSCREENTASK_H
 
 #include <LVMisc/LVTask.h>
-#include <LVMisc/LVLinkList.h>
 #include <LVMisc/LVMemory.h>
 
 class LVScreen;
@@ -15,14 +14,14 @@ class LVScreen;
 class LVScreenTask
         : public LVTask
 {
-    LV_MEMORY
+    LV_MEMORY_SLAB
 
     friend class LVScreen;
 protected:
     LVScreen * m_screen = nullptr; //!< 所属的屏幕
     bool m_runWithScreen; //!< 屏幕显示时就运行
     bool m_stopWithScreen;//!< 屏幕隐藏时就停止
-    LVLLNode<LVScreenTask*> * m_nodeId = nullptr; //!< 在任务列表中的指针
+    int32_t m_taskIndex = -1; //!< 在任务列表中的位置,-1表示未注册
 public:
     /**
      * @brief ScreenTask 屏幕任务构造函数
@@ -0,0 +1,217 @@
+#include "LVScreenTransition.h"
+
+#if LV_USE_SCREEN_TRANSITION
+
+#include <LVCore/LVDispaly.h>
+#include <LVMisc/LVMemoryArena.h>
+#include <lv_core/lv_refr.h>
+
+lv_color_t * LVScreenTransition::s_snapshot = nullptr;
+LVScreenTransition * LVScreenTransition::s_running = nullptr;
+
+bool LVScreenTransition::capture()
+{
+    //画面中可能还有上一次切换的快照
+    finish();
+    release();
+
+    lv_disp_t * disp = lv_disp_get_default();
+    if(disp == nullptr)
+        return false;
+
+    lv_disp_drv_t * drv = &disp->driver;
+    //按像素写入的显示器,缓冲不是图像格式
+    if(drv->set_px_cb)
+        return false;
+
+    LVCoord w = lv_disp_get_hor_res(disp);
+    LVCoord h = lv_disp_get_ver_res(disp);
+
+    //快照不属于任何屏幕
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    lv_color_t * buffer = static_cast<lv_color_t *>(LVMemory::allocate(sizeof(lv_color_t) * w * h));
+    LVMemoryArena::resume(arena);
+    if(buffer == nullptr)
+    {
+        lvWarn("LVScreenTransition no memory for snapshot");
+        return false;
+    }
+
+    //等待正在进行的刷新完成,否则完成通知会落到快照缓冲上
+    lv_disp_buf_t * buf = drv->buffer;
+    while (buf->flushing);
+
+    //整个屏幕作为一个区域绘制,缓冲的排列与图像相同
+    lv_disp_buf_t snapshot;
+    lv_disp_buf_init(&snapshot,buffer,nullptr,(uint32_t)w * h);
+    auto flush = drv->flush_cb;
+    auto rounder = drv->rounder_cb;
+    auto monitor = drv->monitor_cb;
+    drv->buffer = &snapshot;
+    drv->flush_cb = snapshotFlush;
+    drv->rounder_cb = nullptr;
+    drv->monitor_cb = nullptr;
+
+    //顶层和系统层在切换中保持显示,不放进快照
+    lv_obj_t * top = lv_disp_get_layer_top(disp);
+    lv_obj_t * sys = lv_disp_get_layer_sys(disp);
+    bool topHidden = lv_obj_get_hidden(top);
+    bool sysHidden = lv_obj_get_hidden(sys);
+    lv_obj_set_hidden(top,true);
+    lv_obj_set_hidden(sys,true);
+
+    lv_area_t area = { 0, 0, (LVCoord)(w - 1), (LVCoord)(h - 1) };
+    lv_inv_area(disp,nullptr);
+    lv_inv_area(disp,&area);
+    lv_refr_now(disp);
+
+    lv_obj_set_hidden(top,topHidden);
+    lv_obj_set_hidden(sys,sysHidden);
+
+    drv->buffer = buf;
+    drv->flush_cb = flush;
+    drv->rounder_cb = rounder;
+    drv->monitor_cb = monitor;
+
+    //抓取时清除了等待刷新的区域,显示器需要重新刷新
+    lv_inv_area(disp,&area);
+
+    s_snapshot = buffer;
+    return true;
+}
+
+bool LVScreenTransition::start(Effect effect, uint16_t time)
+{
+    if(s_snapshot == nullptr)
+        return false;
+
+    if(effect == EFFECT_NONE || time == 0)
+    {
+        release();
+        return false;
+    }
+
+    //切换动画不属于任何屏幕
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    s_running = new LVScreenTransition(effect,time,s_snapshot);
+    LVMemoryArena::resume(arena);
+    s_snapshot = nullptr;
+    return true;
+}
+
+void LVScreenTransition::release()
+{
+    if(s_snapshot)
+    {
+        LVMemory::free(s_snapshot);
+        s_snapshot = nullptr;
+    }
+}
+
+void LVScreenTransition::finish()
+{
+    if(s_running)
+        delete s_running;
+}
+
+bool LVScreenTransition::isRunning()
+{
+    return s_running != nullptr;
+}
+
+LVScreenTransition::LVScreenTransition(Effect effect, uint16_t time, lv_color_t *buffer)
+    : LVAnimation()
+    , m_buffer(buffer)
+    , m_effect(effect)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    m_width = lv_disp_get_hor_res(disp);
+    m_height = lv_disp_get_ver_res(disp);
+
+    m_style = lv_style_plain;
+    m_style.image.opa = LV_OPA_COVER;
+
+    //放在顶层最下面,顶层原有的对象仍然在上面
+    LVCanvas * canvas = new LVCanvas(LVDisplay::getLayerTop(static_cast<LVDisplay *>(disp)));
+    canvas->setBuffer(m_buffer,m_width,m_height,LV_IMG_CF_TRUE_COLOR);
+    canvas->setStyle(&m_style);
+    canvas->setClickEnable(false);
+    canvas->moveBackground();
+    m_canvas.reset(canvas);
+
+    setValues(0,RATIO_MAX);
+    setTime(time,0);
+    setPath(LVAnimPath::PATH_EASE_OUT);
+    setExecCallBack(execCallBack);
+}
+
+LVScreenTransition::~LVScreenTransition()
+{
+    //动画结束时由动画框架删除
+    if(m_canvas)
+        delete m_canvas.get();
+    LVMemory::free(m_buffer);
+    if(s_running == this)
+        s_running = nullptr;
+}
+
+void LVScreenTransition::apply(LVAnimValue ratio)
+{
+    LVCanvas * canvas = m_canvas.get();
+    if(canvas == nullptr)
+        return;
+
+    LVCoord dx = (LVCoord)(((int32_t)m_width * ratio) >> 8);
+    LVCoord dy = (LVCoord)(((int32_t)m_height * ratio) >> 8);
+
+    switch (m_effect)
+    {
+    case EFFECT_FADE:
+        m_style.image.opa = (lv_opa_t)(((int32_t)LV_OPA_COVER * (RATIO_MAX - ratio)) >> 8);
+        canvas->invalidate();
+        break;
+    case EFFECT_SLIDE_LEFT:
+        canvas->setX(-dx);
+        break;
+    case EFFECT_SLIDE_RIGHT:
+        canvas->setX(dx);
+        break;
+    case EFFECT_SLIDE_UP:
+        canvas->setY(-dy);
+        break;
+    case EFFECT_SLIDE_DOWN:
+        canvas->setY(dy);
+        break;
+    //屏幕不能移动,覆盖时裁掉快照被新屏幕盖住的部分
+    case EFFECT_COVER_LEFT:
+        canvas->setWidth(m_width - dx);
+        break;
+    case EFFECT_COVER_RIGHT:
+        canvas->setX(dx);
+        canvas->setWidth(m_width - dx);
+        lv_img_set_offset_x(canvas,dx);
+        break;
+    case EFFECT_COVER_UP:
+        canvas->setHeight(m_height - dy);
+        break;
+    case EFFECT_COVER_DOWN:
+        canvas->setY(dy);
+        canvas->setHeight(m_height - dy);
+        lv_img_set_offset_y(canvas,dy);
+        break;
+    default:
+        break;
+    }
+}
+
+void LVScreenTransition::execCallBack(LVAnimation *anim, LVAnimValue value)
+{
+    static_cast<LVScreenTransition *>(anim)->apply(value);
+}
+
+void LVScreenTransition::snapshotFlush(lv_disp_drv_t *drv, const lv_area_t * /*area*/, lv_color_t * /*color_p*/)
+{
+    lv_disp_flush_ready(drv);
+}
+
+#endif // LV_USE_SCREEN_TRANSITION
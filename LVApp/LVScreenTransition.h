@@ -0,0 +1,129 @@
+#ifndef LVSCREENTRANSITION_H
+#define LVSCREENTRANSITION_H
+
+#include <LVMisc/LVAnimation.h>
+#include <LVCore/LVPointer.h>
+#include <LVCore/LVStyle.h>
+#include <LVObjx/LVCanvas.h>
+
+/**
+ * 屏幕切换动画,需要画布和动画
+ */
+#ifndef LV_USE_SCREEN_TRANSITION
+#if LV_USE_CANVAS && LV_USE_ANIMATION && LV_USE_POINTER
+#define LV_USE_SCREEN_TRANSITION 1
+#else
+#define LV_USE_SCREEN_TRANSITION 0
+#endif
+#endif
+
+/**
+ * 默认的切换时间(毫秒)
+ */
+#ifndef LV_SCREEN_TRANSITION_TIME
+#define LV_SCREEN_TRANSITION_TIME 250
+#endif
+
+#if LV_USE_SCREEN_TRANSITION
+
+/**
+ * @brief 屏幕切换动画
+ * 切换前把正在显示的画面绘制到一块全屏的快照缓冲中(只绘制一次),
+ * 旧屏幕隐藏(可能被清理)后,快照作为画布放在顶层上,切换过程中只移动或淡出快照,
+ * 新屏幕在下面正常显示,旧屏幕的控件不再绘制;结束后删除画布,释放快照.
+ *
+ * 快照需要 宽x高 个 lv_color_t 的内存,申请失败或显示器使用 set_px_cb 时直接切换.
+ *
+ * 一般通过 LVScreen::setTransition() 使用:
+ * settings->setTransition(LVScreenTransition::EFFECT_SLIDE_LEFT);
+ * settings->show(this);
+ */
+class LVScreenTransition
+        : public LVAnimation
+{
+    LV_MEMORY
+
+public:
+    /**
+     * @brief 切换效果
+     */
+    enum Effect : uint8_t
+    {
+        EFFECT_NONE,        //!< 直接切换
+        EFFECT_FADE,        //!< 旧画面淡出
+        EFFECT_SLIDE_LEFT,  //!< 旧画面向左滑出
+        EFFECT_SLIDE_RIGHT, //!< 旧画面向右滑出
+        EFFECT_SLIDE_UP,    //!< 旧画面向上滑出
+        EFFECT_SLIDE_DOWN,  //!< 旧画面向下滑出
+        EFFECT_COVER_LEFT,  //!< 新屏幕从右向左覆盖旧画面
+        EFFECT_COVER_RIGHT, //!< 新屏幕从左向右覆盖旧画面
+        EFFECT_COVER_UP,    //!< 新屏幕从下向上覆盖旧画面
+        EFFECT_COVER_DOWN,  //!< 新屏幕从上向下覆盖旧画面
+    };
+
+    //! 动画值的最大值
+    static constexpr LVAnimValue RATIO_MAX = 256;
+
+    /**
+     * @brief 抓取默认显示器正在显示的画面
+     * 不包括顶层和系统层,它们在切换过程中保持显示.
+     * 正在进行的切换会先结束.
+     * @return 是否抓取成功
+     */
+    static bool capture();
+
+    /**
+     * @brief 用抓取的快照开始切换,应该在新屏幕加载之后调用
+     * @param effect
+     * @param time 切换时间(毫秒)
+     * @return 没有快照时返回false
+     */
+    static bool start(Effect effect, uint16_t time = LV_SCREEN_TRANSITION_TIME);
+
+    /**
+     * @brief 释放未使用的快照(屏幕未能显示时)
+     */
+    static void release();
+
+    /**
+     * @brief 立即结束正在进行的切换
+     */
+    static void finish();
+
+    /**
+     * @brief 是否正在切换
+     * @return
+     */
+    static bool isRunning();
+
+protected:
+    static lv_color_t * s_snapshot;         //!< 抓取后未开始的快照
+    static LVScreenTransition * s_running;  //!< 正在进行的切换
+
+    LVPointer<LVCanvas> m_canvas;   //!< 显示快照的画布
+    lv_color_t * m_buffer;          //!< 快照,切换结束时释放
+    LVStyle m_style;                //!< 画布样式,淡出时修改透明度
+    Effect m_effect;
+    LVCoord m_width;
+    LVCoord m_height;
+
+    LVScreenTransition(Effect effect, uint16_t time, lv_color_t * buffer);
+    ~LVScreenTransition() override;
+
+    /**
+     * @brief 按进度放置快照
+     * @param ratio [0..RATIO_MAX]
+     */
+    void apply(LVAnimValue ratio);
+
+    static void execCallBack(LVAnimation * anim, LVAnimValue value);
+
+    /**
+     * @brief 抓取时的刷新函数,画面已经在快照中,不输出到显示器
+     */
+    static void snapshotFlush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+};
+
+#endif // LV_USE_SCREEN_TRANSITION
+
+#endif // LVSCREENTRANSITION_H
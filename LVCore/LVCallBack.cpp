@@ -0,0 +1,28 @@
+#include "LVCallBack.h"
+#include <LVMisc/LVMemoryPool.h>
+
+static LVMemoryPool & callBackPool()
+{
+    static LVMemoryPool pool(sizeof(LVCallBackBlock) + LV_CALLBACK_POOL_SIZE,LV_CALLBACK_POOL_CHUNK);
+    return pool;
+}
+
+void *LVCallBackStorage::allocate(size_t size)
+{
+    if(size <= sizeof(LVCallBackBlock) + LV_CALLBACK_POOL_SIZE)
+        return callBackPool().allocate();
+    return LVMemory::allocate(size);
+}
+
+void LVCallBackStorage::free(void *data, size_t size)
+{
+    if(size <= sizeof(LVCallBackBlock) + LV_CALLBACK_POOL_SIZE)
+        callBackPool().free(data);
+    else
+        LVMemory::free(data);
+}
+
+uint32_t LVCallBackStorage::usedCount()
+{
+    return callBackPool().usedCount();
+}
@@ -3,16 +3,112 @@
 
 #include <functional>
 #include <type_traits>
+#include <utility>
 #include <lv_misc/lv_mem.h>
 
+/**
+ * 回调对象内部可以直接存放的可执行对象字节数
+ * 为0时回调对象只占一个指针大小,可执行对象都放在共享的存储块中
+ */
+#ifndef LV_CALLBACK_INLINE_SIZE
+#define LV_CALLBACK_INLINE_SIZE 0
+#endif
+
+/**
+ * 可执行对象不超过这个字节数时,存储块从固定块内存池中分配
+ */
+#ifndef LV_CALLBACK_POOL_SIZE
+#define LV_CALLBACK_POOL_SIZE (4*sizeof(void*))
+#endif
+
+/**
+ * 存储块内存池每次扩充的数量
+ */
+#ifndef LV_CALLBACK_POOL_CHUNK
+#define LV_CALLBACK_POOL_CHUNK 16
+#endif
+
+/**
+ * @brief 可执行对象存储块的头部,后面紧跟可执行对象
+ */
+struct LVCallBackBlock
+{
+    const void * ops; //!< 可执行对象的操作表
+    uintptr_t refs;   //!< 共享的回调对象数量,内嵌时不使用
+};
+
+/**
+ * @brief 可执行对象存储块的分配
+ * 小的可执行对象从固定块内存池中分配,不会在LVGL堆中留下碎片
+ */
+class LVCallBackStorage
+{
+public:
+    static void * allocate(size_t size);
+    static void free(void * data,size_t size);
+
+    /**
+     * @brief 内存池中正在使用的存储块数量
+     * @return
+     */
+    static uint32_t usedCount();
+};
+
+/**
+ * @brief 回调对象内嵌的存储空间
+ */
+template<size_t InlineSize>
+struct LVCallBackInline
+{
+    LVCallBackBlock m_inlineBlock;
+    alignas(void*) uint8_t m_inlineData[InlineSize];
+};
+
+template<>
+struct LVCallBackInline<0>
+{};
+
+template<typename MethodSignature>
+struct LVCallBackInvoker;
+
+template<typename R,typename... A>
+struct LVCallBackInvoker<R(A...)>
+{
+    using Invoke = R(*)(void *,A...);
+
+    template<typename T>
+    static R invoke(void * callable,A... args)
+    {
+        return (*static_cast<T *>(callable))(std::forward<A>(args)...);
+    }
+
+    /**
+     * @brief 把回调对象包装为 std::function,参数类型与函数签名一致(C++11)
+     */
+    template<typename T>
+    static std::function<R(A...)> wrap(const T & callBack)
+    {
+        return [callBack](A... args) mutable -> R { return callBack(std::forward<A>(args)...); };
+    }
+};
+
 /**
  * @brief 可选函数指针或者可执行对象的回调函数
  * 由于使用std:functional耗内存,但是能够加快开发,
  * 为了同时兼容使用函数指针或者可执行对象来做回调函数,
  * 灵活控制内存占用,才写了这样一个中间类
+ *
+ * 函数指针和无捕获的拉姆达表达式只占一个指针,不申请内存.
+ * 有捕获的可执行对象直接存放(不经过std::function),
+ * 不超过 InlineSize 时存放在回调对象内部,
+ * 否则存放在引用计数的存储块中,拷贝回调对象只增加引用计数.
+ *
+ * NOTE: 共享存储块的拷贝共用同一个可执行对象,
+ *       mutable 拉姆达的捕获状态在拷贝之间是共享的;
+ *       引用计数非线程安全,只能在GUI线程中拷贝
  */
-template<typename MethodSignature,typename ReturnType>
-class LVCallBack
+template<typename MethodSignature,typename ReturnType,size_t InlineSize = LV_CALLBACK_INLINE_SIZE>
+class LVCallBack : private LVCallBackInline<InlineSize>
 {
     //加入内存管理,代价昂贵
     static void* operator new(size_t sz)
@@ -54,10 +150,53 @@ public:
     using FuncPtr = MethodSignature* ;
 
 private:
+    using Invoker = LVCallBackInvoker<MethodSignature>;
+
+    /**
+     * @brief 可执行对象的操作表,每种可执行对象类型一份
+     */
+    struct Ops
+    {
+        typename Invoker::Invoke invoke;
+        void (*destroy)(void * callable);
+        void (*copy)(void * dst,const void * src); //!< 内嵌时拷贝构造
+        size_t size;
+    };
+
+    template<typename T>
+    static void destroyCallable(void * callable)
+    {
+        static_cast<T *>(callable)->~T();
+    }
+
+    template<typename T>
+    static void copyCallable(void * dst,const void * src)
+    {
+        new (dst) T(*static_cast<const T *>(src));
+    }
+
+    template<typename T>
+    static const Ops * opsOf()
+    {
+        static const Ops ops = {&Invoker::template invoke<T>,&destroyCallable<T>,&copyCallable<T>,sizeof(T)};
+        return &ops;
+    }
+
+    /**
+     * @brief 能否存放在回调对象内部
+     */
+    template<typename T>
+    struct IsInline
+    {
+        static constexpr bool value = sizeof(T) <= InlineSize &&
+                                      alignof(T) <= alignof(void*) &&
+                                      std::is_copy_constructible<T>::value;
+    };
+
     //使用位域减少内存使用,限制就是,仅支持31位地址寻址
     struct
     {
-        uintptr_t m_pointer :sizeof(uintptr_t)*8-1 ; //!< 可执行对象 (StdFunc*) (MethodSignature*)
+        uintptr_t m_pointer :sizeof(uintptr_t)*8-1 ; //!< 可执行对象 (LVCallBackBlock*) (MethodSignature*)
         uintptr_t m_type     :1  ; //!< 内部数据类型
     };
 
@@ -69,59 +208,41 @@ public:
         m_type = FUNC_PTR;
     }
 
-    //TODO:解决Lambda的初始化问题
-    template<typename T>
-    LVCallBack(const T & t)
-        :LVCallBack(StdFunc(t))
-    {}
+    /**
+     * @brief 由可执行对象构造,无捕获的拉姆达表达式转为函数指针
+     */
+    template<typename T,
+             typename D = typename std::decay<T>::type,
+             typename = typename std::enable_if<!std::is_same<D,LVCallBack>::value &&
+                                                !std::is_same<D,StdFunc>::value &&
+                                                !std::is_same<D,std::nullptr_t>::value>::type>
+    LVCallBack(T && t)
+    {
+        m_pointer = (uintptr_t)(nullptr);
+        m_type = FUNC_PTR;
+        assign<D>(std::forward<T>(t),std::is_convertible<D,MethodSignature *>());
+    }
 
     LVCallBack(const StdFunc & callable)
     {
+        m_pointer = (uintptr_t)(nullptr);
+        m_type = FUNC_PTR;
         if(callable)
-        {
-            m_pointer = (uintptr_t)(new StdFunc(callable));
-            m_type = STD_FUNC;
-        }
-        else
-        {
-            m_pointer = (uintptr_t)(nullptr);
-            m_type = FUNC_PTR;
-        }
+            store<StdFunc>(callable);
     }
 
-    LVCallBack(const LVCallBack<MethodSignature,ReturnType> & other)
+    LVCallBack(const LVCallBack & other)
     {
-        if(!other.isNull())
-        {
-            m_type = other.m_type;
-            //deep copy
-            if(other.m_type == STD_FUNC)
-                m_pointer = (uintptr_t)(new StdFunc(other.getStdFunc()));
-            else
-                m_pointer = other.m_pointer;
-        }
-        else
-        {
-            m_pointer = (uintptr_t)(nullptr);
-            m_type = FUNC_PTR;
-        }
+        m_pointer = (uintptr_t)(nullptr);
+        m_type = FUNC_PTR;
+        copyFrom(other);
     }
 
-    LVCallBack(LVCallBack<MethodSignature,ReturnType> && other)
+    LVCallBack(LVCallBack && other)
     {
-        if(!other.isNull())
-        {
-            m_type = other.m_type;
-            m_pointer = other.m_pointer;
-            //take other`s data,then reset it
-            other.m_type = FUNC_PTR;
-            other.m_pointer = (uintptr_t)(nullptr);
-        }
-        else
-        {
-            m_pointer = (uintptr_t)(nullptr);
-            m_type = FUNC_PTR;
-        }
+        m_pointer = (uintptr_t)(nullptr);
+        m_type = FUNC_PTR;
+        moveFrom(other);
     }
 
     ~LVCallBack() {clear();}
@@ -130,10 +251,7 @@ public:
     {
         clear();
         if(callable)
-        {
-            m_pointer = (uintptr_t)(new StdFunc(callable));
-            m_type = STD_FUNC;
-        }
+            store<StdFunc>(callable);
         return *this;
     }
 
@@ -145,42 +263,22 @@ public:
         return *this;
     }
 
-    LVCallBack& operator =(const LVCallBack<MethodSignature,ReturnType> & other)
+    LVCallBack& operator =(const LVCallBack & other)
     {
-        clear();
-
-        if(!other.isNull())
+        if(this != &other)
         {
-            m_type = other.m_type;
-            //deep copy
-            if(other.m_type == STD_FUNC)
-                m_pointer = (uintptr_t)(new StdFunc(other.getStdFunc()));
-            else
-                m_pointer = other.m_pointer;
-        }
-        else
-        {
-            m_pointer = (uintptr_t)(nullptr);
-            m_type = FUNC_PTR;
+            clear();
+            copyFrom(other);
         }
         return *this;
     }
 
-    LVCallBack& operator =(LVCallBack<MethodSignature,ReturnType> && other)
+    LVCallBack& operator =(LVCallBack && other)
     {
-        clear();
-        if(!other.isNull())
+        if(this != &other)
         {
-            m_type = other.m_type;
-            m_pointer = other.m_pointer;
-            //take other`s data,then reset it
-            other.m_type = FUNC_PTR;
-            other.m_pointer = 0;
-        }
-        else
-        {
-            m_pointer = 0;
-            m_type = FUNC_PTR;
+            clear();
+            moveFrom(other);
         }
         return *this;
     }
@@ -218,6 +316,28 @@ public:
         return m_type == STD_FUNC;
     }
 
+    /**
+     * @brief 可执行对象是否存放在回调对象内部
+     * @return
+     */
+    bool isInline() const
+    {
+        return m_type == STD_FUNC && block() == inlineBlock();
+    }
+
+    /**
+     * @brief 共享同一个可执行对象的回调对象数量
+     * @return 函数指针和内嵌的可执行对象返回 1,空对象返回 0
+     */
+    uint32_t useCount() const
+    {
+        if(isNull())
+            return 0;
+        if(m_type == FUNC_PTR || isInline())
+            return 1;
+        return block()->refs;
+    }
+
     /**
      * @brief 清空对象中的数据
      */
@@ -225,7 +345,17 @@ public:
     {
         if (isStdFunc())
         {
-            delete reinterpret_cast<StdFunc*>(m_pointer);
+            LVCallBackBlock * data = block();
+            const Ops * ops = static_cast<const Ops *>(data->ops);
+            if(data == inlineBlock())
+            {
+                ops->destroy(callable(data));
+            }
+            else if(--data->refs == 0)
+            {
+                ops->destroy(callable(data));
+                LVCallBackStorage::free(data,sizeof(LVCallBackBlock) + ops->size);
+            }
         }
         m_pointer = (uintptr_t)nullptr;
         m_type = FUNC_PTR;
@@ -237,18 +367,7 @@ public:
      */
     bool isNull() const
     {
-        if(m_pointer == (uintptr_t)nullptr)
-        {
-            return true;
-        }
-        else if (m_type==STD_FUNC)
-        {
-            return (*(reinterpret_cast<StdFunc*>(m_pointer)))?false:true;
-        }
-        else
-        {
-            return false;
-        }
+        return m_pointer == (uintptr_t)nullptr;
     }
 
     template<class... Args>
@@ -261,11 +380,11 @@ public:
         	LV_LOG_ERROR("LVCallBack: bad_function_call");
         	assert(false);
         }
-        switch (m_type)
-        {
-        case FUNC_PTR: return (*(reinterpret_cast<MethodSignature*>(m_pointer)))(std::forward<Args>(args)...); break;
-        case STD_FUNC: return (*(reinterpret_cast<StdFunc*>(m_pointer)))(std::forward<Args>(args)...); break;
-        }
+        if(m_type == FUNC_PTR)
+            return (*(reinterpret_cast<MethodSignature*>(m_pointer)))(std::forward<Args>(args)...);
+
+        LVCallBackBlock * data = block();
+        return static_cast<const Ops *>(data->ops)->invoke(callable(data),std::forward<Args>(args)...);
     }
 
     MethodSignature* getFuncPtr() const
@@ -273,12 +392,124 @@ public:
         return m_type==FUNC_PTR?reinterpret_cast<MethodSignature*>(m_pointer):nullptr;
     }
 
+    /**
+     * @brief 包装为 std::function,会申请内存,仅用于兼容
+     * @return
+     */
     StdFunc getStdFunc() const
     {
-        return m_type==STD_FUNC?(*(reinterpret_cast<StdFunc*>(m_pointer))):StdFunc(nullptr);
+        if(m_type != STD_FUNC)
+            return StdFunc(nullptr);
+        LVCallBack callBack(*this);
+        return LVCallBackInvoker<MethodSignature>::wrap(callBack);
+    }
+
+private:
+    LVCallBackBlock * block() const
+    {
+        return reinterpret_cast<LVCallBackBlock *>(m_pointer);
+    }
+
+    static void * callable(LVCallBackBlock * data)
+    {
+        return data + 1;
+    }
+
+    LVCallBackBlock * inlineBlock() const
+    {
+        return inlineBlock(std::integral_constant<bool,(InlineSize > 0)>());
+    }
+
+    LVCallBackBlock * inlineBlock(std::true_type) const
+    {
+        return const_cast<LVCallBackBlock *>(&this->m_inlineBlock);
     }
 
-    //TODO: 实现数据获取方法
+    LVCallBackBlock * inlineBlock(std::false_type) const
+    {
+        return nullptr;
+    }
+
+    template<typename D,typename T>
+    void assign(T && t,std::true_type)
+    {
+        m_pointer = (uintptr_t)(static_cast<MethodSignature *>(t));
+        m_type = FUNC_PTR;
+    }
+
+    template<typename D,typename T>
+    void assign(T && t,std::false_type)
+    {
+        store<D>(std::forward<T>(t));
+    }
+
+    /**
+     * @brief 存放可执行对象,优先放在回调对象内部
+     */
+    template<typename D,typename T>
+    void store(T && t)
+    {
+        LVCallBackBlock * data = IsInline<D>::value ? inlineBlock() : nullptr;
+        if(data == nullptr)
+        {
+            data = static_cast<LVCallBackBlock *>(LVCallBackStorage::allocate(sizeof(LVCallBackBlock) + sizeof(D)));
+            if(data == nullptr)
+            {
+                LV_LOG_ERROR("LVCallBack: out of memory");
+                return;
+            }
+        }
+        static_assert(sizeof(LVCallBackBlock) % alignof(void*) == 0,"LVCallBackBlock must keep pointer alignment");
+        new (callable(data)) D(std::forward<T>(t));
+        data->ops = opsOf<D>();
+        data->refs = 1;
+        m_pointer = (uintptr_t)(data);
+        m_type = STD_FUNC;
+    }
+
+    void copyFrom(const LVCallBack & other)
+    {
+        if(other.m_type == STD_FUNC)
+        {
+            LVCallBackBlock * data = other.block();
+            if(data == other.inlineBlock())
+            {
+                //内嵌的可执行对象需要拷贝构造
+                LVCallBackBlock * own = inlineBlock();
+                own->ops = data->ops;
+                own->refs = 1;
+                static_cast<const Ops *>(data->ops)->copy(callable(own),callable(data));
+                data = own;
+            }
+            else
+            {
+                ++data->refs;
+            }
+            m_pointer = (uintptr_t)(data);
+            m_type = STD_FUNC;
+        }
+        else
+        {
+            m_pointer = other.m_pointer;
+            m_type = FUNC_PTR;
+        }
+    }
+
+    void moveFrom(LVCallBack & other)
+    {
+        if(other.isInline())
+        {
+            //内嵌的可执行对象不能转移,拷贝后清空对方
+            copyFrom(other);
+            other.clear();
+            return;
+        }
+        //take other`s data,then reset it
+        m_type = other.m_type;
+        m_pointer = other.m_pointer;
+        other.m_type = FUNC_PTR;
+        other.m_pointer = (uintptr_t)(nullptr);
+    }
 } LV_ATTRIBUTE_MEM_ALIGN ;
 
 #endif // LVCALLBACK_H
@@ -1,6 +1,7 @@
 #include "LVObject.h"
 #include "LVPointer.h"
 #include "LVDispaly.h"
+#include "../LVMisc/LVAnimationGroup.h"
 
 extern "C"
 {
@@ -39,6 +40,11 @@ lv_obj_t * lv_obj_create_custom(void*(*func)(lv_ll_t *), lv_ll_t * ll_p)
  */
 void lv_obj_del_custom(lv_obj_t * obj)
 {
+#if LV_USE_ANIMATION
+    //同 lv_anim_del(obj,NULL),动画组中不能留下已删除的对象
+    LVAnimationGroup::removeAll(obj);
+#endif
+
     if(LVObject::isVaild(obj)) //LVOnjecct类实例
     {
         if(!obj->class_ptr.deleted)
@@ -109,76 +115,51 @@ void LVObject::loadScreen()
 
 void LVObject::addPointer(LVPointerBase *pointer)
 {
-    //初始化智能指针列表
-    if(m_pointers == nullptr)
-    {
-        //默认开辟
-        //BUG:实际分配的内存块可能大于指定数
-        m_pointers = (LVPointerBase **)LVMemory::allocate(sizeof(LVPointerBase*));
-        memset(m_pointers,0,LVMemory::getSize(m_pointers));
-    }
-    //寻找可用的空间
-    uint32_t size = LVMemory::getSize(m_pointers);
-    uint32_t ptrSize = size/sizeof(LVPointerBase*);
-    //lvInfo("objrct(0x%p) add Pointer(0x%p) size:%d",this,m_pointers,size);
-    for (uint32_t i = 0; i < ptrSize; ++i)
-    {
-        if(m_pointers[i] == pointer)
-        {
-            //NOTE:禁止重复关联
-            return;
-        }
-        else if(m_pointers[i] == nullptr)
-        {
-            m_pointers[i] = pointer;
-            return;
-        }
-    }
-    //开辟新空间
-    m_pointers = (LVPointerBase **)LVMemory::reallocate(m_pointers,size+sizeof(LVPointerBase*));
-    //BUG:实际分配的内存块可能大于指定数
-    memset(m_pointers+(ptrSize),0,LVMemory::getSize(m_pointers)-size);
-    m_pointers[ptrSize] = pointer;
+    //NOTE:禁止重复关联
+    if(pointer->m_prev != nullptr || m_pointers == pointer)
+        return;
+
+    //插入到链表头部
+    pointer->m_prev = nullptr;
+    pointer->m_next = m_pointers;
+    if(m_pointers)
+        m_pointers->m_prev = pointer;
+    m_pointers = pointer;
 }
 
 bool LVObject::removePointer(LVPointerBase *pointer)
 {
-    if(m_pointers == nullptr)
+    if(pointer->m_prev)
+        pointer->m_prev->m_next = pointer->m_next;
+    else if(m_pointers == pointer)
+        m_pointers = pointer->m_next;
+    else
     {
-    	lvError("LVObject::removePointer error %p %p",this,pointer);
+        lvError("LVObject::removePointer error %p %p",this,pointer);
         return false; //NOTE:一种错误的情况,不该发生
     }
-    uint32_t size = LVMemory::getSize(m_pointers);
-    //lvInfo("objrct(0x%p) remove Pointer(0x%p) size:%d",this,m_pointers,size);
-    for (uint32_t i = 0, n = size/sizeof(LVPointerBase*) ; i < n; ++i)
-    {
-        if(m_pointers[i] == pointer)
-        {
-            //抹除智能指针关联
-            pointer->m_obj = 0;
-            m_pointers[i] = nullptr;
-            return true;
-        }
-    }
-    return false;
+
+    if(pointer->m_next)
+        pointer->m_next->m_prev = pointer->m_prev;
+
+    //抹除智能指针关联
+    pointer->m_obj = 0;
+    pointer->m_prev = nullptr;
+    pointer->m_next = nullptr;
+    return true;
 }
 
 void LVObject::cleanPointers()
 {
-    if(m_pointers == nullptr)
-        return;
-    uint32_t size = LVMemory::getSize(m_pointers);
-    //lvInfo("objrct(0x%p) clean Pointer(0x%p) size:%d",this,m_pointers,size);
-    for (uint32_t i = 0, n = size/sizeof(LVPointerBase*) ; i < n; ++i)
+    LVPointerBase * pointer = m_pointers;
+    while (pointer)
     {
-        if(m_pointers[i] != nullptr)
-        {
-            m_pointers[i]->m_obj = 0;
-            m_pointers[i] = nullptr;
-        }
+        LVPointerBase * next = pointer->m_next;
+        pointer->m_obj = 0;
+        pointer->m_prev = nullptr;
+        pointer->m_next = nullptr;
+        pointer = next;
     }
-    //清理指针列表
-    LVMemory::free(m_pointers);
     m_pointers = nullptr;
 }
 
@@ -318,11 +318,11 @@ class LVObject
 protected:
 #if LV_USE_POINTER
     /**
-     * @brief 智能指针对象数组
+     * @brief 智能指针对象链表头
      * template< class T> class LVPointer;
-     * [p,p,p,p,p,p,p,...]
+     * 通过 LVPointerBase 中的前后指针串联 p <-> p <-> p ...
      */
-    LVPointerBase ** m_pointers = nullptr;
+    LVPointerBase * m_pointers = nullptr;
 #endif
 
     LVDesignCallBack m_designCallback; //!< 设计回调
@@ -883,6 +883,18 @@ public:
     //    lv_obj_set_design_cb(this,design_cb);
     //}
 
+    /**
+     * @brief 复制另一个对象的回调函数
+     * 创建时复制对象(copy 参数)只复制了 lvgl 的函数指针,类对象中保存的回调需要另外复制
+     * @param copy
+     */
+    void copyCallBacks(const LVObject * copy)
+    {
+        if(copy->m_designCallback) setDesignCallBack(copy->m_designCallback);
+        if(copy->m_signalCallback) setSignalCallBack(copy->m_signalCallback);
+        if(copy->m_eventCallback) setEventCallBack(copy->m_eventCallback);
+    }
+
     /*----------------
      * Other set
      *--------------*/
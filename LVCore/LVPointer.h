@@ -38,6 +38,9 @@ protected:
         uintptr_t m_data;
     };
 
+    LVPointerBase * m_prev = nullptr; //!< 指向同一对象的上一个指针
+    LVPointerBase * m_next = nullptr; //!< 指向同一对象的下一个指针
+
     LVPointerBase(LVObject * obj = nullptr,bool scoped = false)
     {
         m_obj = 0;
@@ -46,6 +49,10 @@ protected:
             setObject(obj);
     }
 
+    //链表节点不可拷贝
+    LVPointerBase(const LVPointerBase&) = delete;
+    LVPointerBase& operator = (const LVPointerBase&) = delete;
+
 public:
 
     ~LVPointerBase()
@@ -0,0 +1,196 @@
+#include "LVPrototype.h"
+#include <string.h>
+
+#if LV_USE_CONT
+#include <lv_objx/lv_cont.h>
+#endif
+
+LVObject *LVPrototype::get(const char *name)
+{
+    Prototype * proto = find(name);
+    return proto ? proto->nodes[0].object : nullptr;
+}
+
+bool LVPrototype::remove(const char *name)
+{
+    LVVector<Prototype *> & list = prototypes();
+    for (uint32_t i = 0; i < list.size(); ++i)
+    {
+        Prototype * proto = list[i];
+        if(strcmp(proto->name,name) == 0)
+        {
+            list.erase(list.begin() + i);
+            //删除根对象时子对象一起删除
+            delete proto->nodes[0].object;
+            LVMemory::free(proto->name);
+            delete proto;
+            return true;
+        }
+    }
+    return false;
+}
+
+void LVPrototype::clear()
+{
+    LVVector<Prototype *> & list = prototypes();
+    while (!list.empty())
+        remove(list.back()->name);
+}
+
+uint32_t LVPrototype::count()
+{
+    return prototypes().size();
+}
+
+LVObject *LVPrototype::holder()
+{
+    static LVObject * s_holder = nullptr;
+    if(s_holder == nullptr)
+    {
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        s_holder = new LVObject(nullptr);
+        LVMemoryArena::resume(arena);
+    }
+    return s_holder;
+}
+
+LVVector<LVPrototype::Prototype *> &LVPrototype::prototypes()
+{
+    static LVVector<Prototype *> s_prototypes;
+    return s_prototypes;
+}
+
+LVPrototype::Prototype *LVPrototype::find(const char *name)
+{
+    LVVector<Prototype *> & list = prototypes();
+    for (uint32_t i = 0; i < list.size(); ++i)
+    {
+        if(strcmp(list[i]->name,name) == 0)
+            return list[i];
+    }
+    return nullptr;
+}
+
+void LVPrototype::addPrototype(const char *name, LVObject *root, Factory factory)
+{
+    remove(name);
+
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    Prototype * proto = new Prototype;
+    proto->name = static_cast<char *>(LVMemory::allocate(strlen(name) + 1));
+    strcpy(proto->name,name);
+    proto->nodes.push_back({ root, factory, -1, false });
+    prototypes().push_back(proto);
+    LVMemoryArena::resume(arena);
+}
+
+bool LVPrototype::addNode(LVObject *parent, LVObject *obj, Factory factory)
+{
+    LVVector<Prototype *> & list = prototypes();
+    for (uint32_t i = 0; i < list.size(); ++i)
+    {
+        LVVector<Node> & nodes = list[i]->nodes;
+        for (uint32_t j = 0; j < nodes.size(); ++j)
+        {
+            if(nodes[j].object == parent)
+            {
+                nodes[j].hasChildren = true;
+                LVMemoryArena * arena = LVMemoryArena::suspend();
+                nodes.push_back({ obj, factory, (int16_t)j, false });
+                LVMemoryArena::resume(arena);
+                return true;
+            }
+        }
+    }
+    lvError("LVPrototype::add parent(0x%p) is not in any prototype",parent);
+    return false;
+}
+
+#if LV_USE_CONT
+/**
+ * 有自动布局或自适应大小的容器,添加子对象时会重新计算
+ */
+static bool isLayoutCont(lv_obj_t * obj)
+{
+    lv_obj_type_t type;
+    lv_obj_get_type(obj,&type);
+    bool cont = false;
+    for (uint8_t i = 0; i < LV_MAX_ANCESTOR_NUM && type.type[i]; ++i)
+    {
+        if(strcmp(type.type[i],"lv_cont") == 0)
+        {
+            cont = true;
+            break;
+        }
+    }
+    if(!cont)
+        return false;
+
+    lv_layout_t layout = lv_cont_get_layout(obj);
+    lv_fit_t left = lv_cont_get_fit_left(obj);
+    lv_fit_t right = lv_cont_get_fit_right(obj);
+    lv_fit_t top = lv_cont_get_fit_top(obj);
+    lv_fit_t bottom = lv_cont_get_fit_bottom(obj);
+    return layout != LV_LAYOUT_OFF ||
+           left != LV_FIT_NONE || right != LV_FIT_NONE || top != LV_FIT_NONE || bottom != LV_FIT_NONE;
+}
+#endif
+
+LVObject *LVPrototype::cloneTree(const char *name, LVObject *parent)
+{
+    Prototype * proto = find(name);
+    if(proto == nullptr)
+    {
+        lvWarn("LVPrototype::clone [%s] not found",name);
+        return nullptr;
+    }
+
+    //克隆中不会再克隆,共用一个列表
+    static LVVector<LVObject *> s_clones;
+    LVVector<Node> & nodes = proto->nodes;
+    uint32_t n = nodes.size();
+    if(s_clones.size() < n)
+    {
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        s_clones.resize(n);
+        LVMemoryArena::resume(arena);
+    }
+
+    //在不显示的屏幕上创建,不产生重绘区域
+    LVObject * holderObj = holder();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const Node & node = nodes[i];
+        LVObject * par = node.parent < 0 ? holderObj : s_clones[node.parent];
+        LVObject * obj = node.factory(par,node.object);
+        obj->copyCallBacks(node.object);
+#if LV_USE_CONT
+        //子对象创建完之前不计算布局
+        if(node.hasChildren && isLayoutCont(node.object))
+        {
+            lv_cont_set_layout(obj,LV_LAYOUT_OFF);
+            lv_cont_set_fit(obj,LV_FIT_NONE);
+        }
+#endif
+        s_clones[i] = obj;
+    }
+
+#if LV_USE_CONT
+    //从子对象向上恢复,每个容器只计算一次
+    for (int32_t i = (int32_t)n - 1; i >= 0; --i)
+    {
+        lv_obj_t * src = nodes[i].object;
+        if(!nodes[i].hasChildren || !isLayoutCont(src))
+            continue;
+        lv_obj_t * obj = s_clones[i];
+        lv_cont_set_fit4(obj,lv_cont_get_fit_left(src),lv_cont_get_fit_right(src),
+                         lv_cont_get_fit_top(src),lv_cont_get_fit_bottom(src));
+        lv_cont_set_layout(obj,lv_cont_get_layout(src));
+    }
+#endif
+
+    LVObject * root = s_clones[0];
+    if(parent)
+        lv_obj_set_parent(root,parent);
+    return root;
+}
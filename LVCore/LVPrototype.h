@@ -0,0 +1,152 @@
+#ifndef LVPROTOTYPE_H
+#define LVPROTOTYPE_H
+
+#include "LVObject.h"
+#include "../LVMisc/LVMemoryArena.h"
+#include "../LVMisc/lvvector.h"
+
+/**
+ * @brief 控件原型
+ * 把配置好的控件树(样式,大小,回调,子对象布局)注册一次,之后按原型克隆,
+ * 不需要每次重复调用设置函数.克隆时:
+ * - 每个对象用 copy 参数创建,样式,大小和控件属性一次复制
+ * - 整棵树先在一个不显示的屏幕上创建,期间不产生重绘区域,最后一次放到父对象中
+ * - 容器的自动布局和自适应大小在创建子对象时暂停,最后每个容器只计算一次
+ *
+ * 原型树中的对象需要通过 create()/add() 创建,记录各自的类型:
+ * LVButton * key = LVPrototype::create<LVButton>("keypad.key");
+ * key->setSize(60,40);
+ * key->setEventCallBack(onKey);
+ * LVPrototype::add<LVLabel>(key)->setAlign(ALIGN_CENTER);
+ * ...
+ * for (int i = 0; i < 12; ++i)
+ *     LVPrototype::clone<LVButton>("keypad.key",keypad);
+ */
+class LVPrototype
+{
+public:
+    using Factory = LVObject * (*)(LVObject * parent, const LVObject * copy);
+
+    /**
+     * @brief 创建原型的根对象
+     * 同名的原型会被替换
+     * @param name 原型名称
+     * @return
+     */
+    template<class T>
+    static T * create(const char * name)
+    {
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        T * obj = new T(holder());
+        LVMemoryArena::resume(arena);
+        addPrototype(name,obj,make<T>);
+        return obj;
+    }
+
+    /**
+     * @brief 在原型中创建子对象
+     * @param parent 原型中的对象
+     * @return parent 不属于任何原型时返回nullptr
+     */
+    template<class T>
+    static T * add(LVObject * parent)
+    {
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        T * obj = new T(parent);
+        LVMemoryArena::resume(arena);
+        if(!addNode(parent,obj,make<T>))
+        {
+            delete obj;
+            return nullptr;
+        }
+        return obj;
+    }
+
+    /**
+     * @brief 按原型克隆控件树
+     * @param name 原型名称
+     * @param parent 新对象的父对象
+     * @return 原型不存在时返回nullptr
+     */
+    template<class T = LVObject>
+    static T * clone(const char * name, LVObject * parent)
+    {
+        return static_cast<T *>(cloneTree(name,parent));
+    }
+
+    /**
+     * @brief 原型的根对象
+     * @param name
+     * @return
+     */
+    static LVObject * get(const char * name);
+
+    /**
+     * @brief 删除原型
+     * @param name
+     * @return
+     */
+    static bool remove(const char * name);
+
+    /**
+     * @brief 删除所有原型
+     */
+    static void clear();
+
+    /**
+     * @brief 原型数量
+     * @return
+     */
+    static uint32_t count();
+
+protected:
+    /**
+     * @brief 原型中的对象
+     */
+    struct Node
+    {
+        LVObject * object;  //!< 原型对象
+        Factory factory;    //!< 以原型对象为副本创建同类对象
+        int16_t parent;     //!< 父节点的序号,根节点为-1
+        bool hasChildren;   //!< 是否有子节点
+    };
+
+    /**
+     * @brief 一个原型,节点按创建顺序排列,父节点总在子节点之前
+     */
+    struct Prototype
+    {
+        LV_MEMORY
+
+    public:
+        char * name = nullptr;
+        LVVector<Node> nodes;
+    };
+
+    template<class T>
+    static LVObject * make(LVObject * parent, const LVObject * copy)
+    {
+        return new T(parent,static_cast<const T *>(copy));
+    }
+
+    /**
+     * @brief 存放原型和克隆中的控件树的屏幕,从不加载,其中的对象不绘制
+     */
+    static LVObject * holder();
+
+    static LVVector<Prototype *> & prototypes();
+
+    static Prototype * find(const char * name);
+
+    static void addPrototype(const char * name, LVObject * root, Factory factory);
+
+    static bool addNode(LVObject * parent, LVObject * obj, Factory factory);
+
+    static LVObject * cloneTree(const char * name, LVObject * parent);
+
+private:
+    LVPrototype() = delete;
+    ~LVPrototype() = delete;
+};
+
+#endif // LVPROTOTYPE_H
@@ -0,0 +1,121 @@
+#include "LVSignalQueue.h"
+#include "LVSignalSlot.h"
+#include <LVMisc/LVTask.h>
+
+static_assert((LV_SIGNAL_QUEUE_SIZE & (LV_SIGNAL_QUEUE_SIZE - 1)) == 0, "LV_SIGNAL_QUEUE_SIZE must be a power of 2");
+
+LVSignalQueue::LVSignalQueue()
+{
+    m_task = new LVTask(dispatchAgent,1,LVTask::PRIO_MID);
+    m_task->setUserData(this);
+}
+
+LVSignalQueue::~LVSignalQueue()
+{
+    //排队中的连接不再执行
+    for (uint32_t i = 0; i < m_count; ++i)
+    {
+        LVConnection * connection = m_buffer[(m_head + i) & (m_capacity - 1)];
+        if(connection)
+            connection->m_queued = 0;
+    }
+    delete m_task;
+    lv_mem_free(m_buffer);
+}
+
+LVSignalQueue *LVSignalQueue::getDefault()
+{
+    static LVSignalQueue * queue = nullptr;
+    if(queue == nullptr)
+    {
+        //全局队列不进入屏幕的内存区
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        queue = new LVSignalQueue();
+        LVMemoryArena::resume(arena);
+    }
+    return queue;
+}
+
+uint32_t LVSignalQueue::dispatch()
+{
+    uint32_t dispatched = 0;
+    //只执行本次开始前排队的连接
+    for (uint32_t n = m_count; n > 0 && m_count > 0; --n)
+    {
+        LVConnection * connection = m_buffer[m_head];
+        m_head = (m_head + 1) & (m_capacity - 1);
+        --m_count;
+
+        //被删除的连接已经置空
+        if(connection)
+        {
+            --connection->m_queued;
+            //执行后连接可能已被删除,不能再访问
+            connection->invoke();
+            ++dispatched;
+        }
+    }
+
+    if(m_count == 0)
+        m_task->stop();
+
+    return dispatched;
+}
+
+bool LVSignalQueue::enqueue(LVConnection *connection)
+{
+    if(m_count == m_capacity && !grow())
+        return false;
+
+    m_buffer[(m_head + m_count) & (m_capacity - 1)] = connection;
+    ++connection->m_queued;
+    if(++m_count > m_peakCount)
+        m_peakCount = m_count;
+
+    //从空队列开始时启动派发任务
+    if(m_count == 1)
+        m_task->start();
+    return true;
+}
+
+void LVSignalQueue::cancel(LVConnection *connection)
+{
+    for (uint32_t i = 0; i < m_count && connection->m_queued; ++i)
+    {
+        LVConnection *& entry = m_buffer[(m_head + i) & (m_capacity - 1)];
+        if(entry == connection)
+        {
+            entry = nullptr;
+            --connection->m_queued;
+        }
+    }
+}
+
+bool LVSignalQueue::grow()
+{
+    uint32_t capacity = m_capacity ? m_capacity * 2 : LV_SIGNAL_QUEUE_SIZE;
+    //缓冲在所有屏幕之间共用,直接在LVGL堆上分配
+    LVConnection ** buffer = static_cast<LVConnection **>(lv_mem_alloc(capacity * sizeof(LVConnection *)));
+    if(buffer == nullptr)
+    {
+        lvError("LVSignalQueue: out of memory, queued connections : %d",m_count);
+        return false;
+    }
+
+    //按顺序展开到新的缓冲
+    for (uint32_t i = 0; i < m_count; ++i)
+        buffer[i] = m_buffer[(m_head + i) & (m_capacity - 1)];
+
+    lv_mem_free(m_buffer);
+    m_buffer = buffer;
+    m_capacity = capacity;
+    m_head = 0;
+    return true;
+}
+
+void LVSignalQueue::dispatchAgent(LVTask *task)
+{
+    LVSignalQueue * queue = static_cast<LVSignalQueue *>(task->getUserData());
+    if(queue)
+        queue->dispatch();
+}
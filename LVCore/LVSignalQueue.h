@@ -0,0 +1,110 @@
+#ifndef LVSIGNALQUEUE_H
+#define LVSIGNALQUEUE_H
+
+#include <stdint.h>
+#include <LVMisc/LVMemory.h>
+
+class LVConnection;
+class LVTask;
+
+/**
+ * 队列环形缓冲的初始容量(2的幂),不够时翻倍扩充
+ */
+#ifndef LV_SIGNAL_QUEUE_SIZE
+#define LV_SIGNAL_QUEUE_SIZE 32
+#endif
+
+/**
+ * @brief 队列连接的延迟派发队列
+ * QueueConnect 的连接在信号发送时只是放入环形缓冲,
+ * 由一个常驻的任务在下一次任务处理时一次性全部执行,
+ * 不再为每次发送创建任务和可执行对象.
+ *
+ * 所有显示器共用同一个任务处理器,所以整个GUI线程只有一个队列.
+ *
+ * NOTE: 非线程安全,只能在GUI线程中使用
+ */
+class LVSignalQueue
+{
+    LV_MEMORY
+
+    friend class LVConnection;
+protected:
+    LVConnection ** m_buffer = nullptr; //!< 环形缓冲
+    uint32_t m_capacity = 0;            //!< 缓冲容量(2的幂)
+    uint32_t m_head = 0;                //!< 队头位置
+    uint32_t m_count = 0;               //!< 排队的连接数量
+    uint32_t m_peakCount = 0;           //!< 排队数量峰值
+    uint32_t m_coalescedCount = 0;      //!< 被合并掉的发送次数
+    LVTask * m_task = nullptr;          //!< 派发任务
+
+    LVSignalQueue();
+
+public:
+    ~LVSignalQueue();
+
+    /**
+     * @brief 获取GUI线程的派发队列
+     * 第一次使用时创建,需要在LVGL初始化之后调用
+     * @return
+     */
+    static LVSignalQueue * getDefault();
+
+    /**
+     * @brief 执行所有已经排队的连接
+     * 执行过程中新加入的连接留到下一次执行,避免无限循环
+     * @return 执行的连接数量
+     */
+    uint32_t dispatch();
+
+    /**
+     * @brief 排队中的连接数量
+     * @return
+     */
+    uint32_t size() const { return m_count; }
+
+    bool isEmpty() const { return m_count == 0; }
+
+    uint32_t capacity() const { return m_capacity; }
+
+    uint32_t peakSize() const { return m_peakCount; }
+
+    /**
+     * @brief 因合并而省去的执行次数
+     * @return
+     */
+    uint32_t coalescedCount() const { return m_coalescedCount; }
+
+protected:
+
+    /**
+     * @brief 连接加入队列
+     * @param connection
+     * @return false 内存不足,没能加入队列
+     */
+    bool enqueue(LVConnection * connection);
+
+    /**
+     * @brief 清除队列中某个连接的所有记录,连接删除时调用
+     * @param connection
+     */
+    void cancel(LVConnection * connection);
+
+    /**
+     * @brief 扩充环形缓冲
+     * @return
+     */
+    bool grow();
+
+    /**
+     * @brief 派发任务的回调
+     * @param task
+     */
+    static void dispatchAgent(LVTask * task);
+
+private:
+    LVSignalQueue(const LVSignalQueue&) = delete;
+    LVSignalQueue& operator = (const LVSignalQueue&) = delete;
+};
+
+#endif // LVSIGNALQUEUE_H
@@ -2,39 +2,69 @@
 #define LVSIGNALSLOT_H
 
 #include <functional>
-#include <LVMisc/LVLinkList.h>
 #include <LVMisc/LVMemory.h>
+#include <LVMisc/LVMemoryPool.h>
+#include <LVMisc/LVMemorySlab.h>
 #include <LVCore/LVCallBack.h>
 
 class LVSignal;
 class LVSlot;
 class LVConnection;
+template<class... Args> class LVSignalT;
+template<class... Args> class LVSlotT;
 
 /**
- *  槽对象列表
+ * 连接对象在内存池中每次扩充的数量
  */
-using LVSlotList = LVLinkList<LVConnection*>;
+#ifndef LV_CONNECTION_POOL_CHUNK
+#define LV_CONNECTION_POOL_CHUNK 32
+#endif
 
 /**
- *  信号对象列表
+ * @brief 连接在链表中的前后关系
+ * 直接嵌入在连接对象中,不需要额外的链表节点
  */
-using LVSignalList = LVLinkList<LVConnection*>;
-
+struct LVConnectionLink
+{
+    LVConnection * prev = nullptr;
+    LVConnection * next = nullptr;
+};
 
 /**
- * LVSignal 在链表中的节点对象
+ * @brief 侵入式的连接链表
+ * 通过连接对象中嵌入的 LVConnectionLink 串联,
+ * 插入和移除都是O(1),不申请任何内存
+ * @tparam Side 使用连接对象中哪一侧的链接
  */
-using SignalNode = LVLLNode<LVSignal*>;
+template<uint8_t Side>
+class LVConnectionList
+{
+    LVConnection * m_head = nullptr; //!< 第一个连接
+    LVConnection * m_tail = nullptr; //!< 最后一个连接
+public:
+    LVConnection * getHead() const { return m_head; }
+    LVConnection * getTail() const { return m_tail; }
+    static LVConnection * getNext(const LVConnection * connection);
+    static LVConnection * getPrev(const LVConnection * connection);
+    bool isEmpty() const { return m_head == nullptr; }
 
-/**
- * LVSlot 在链表中的节点对象
- */
-using SlotNode = LVLLNode<LVSlot*>;
+    /**
+     * @brief 在链表尾部加入连接,保证按连接顺序执行
+     * @param connection
+     */
+    void insertTail(LVConnection * connection);
 
-/**
- * Connection 在链表中的节点对象
- */
-using ConnectionNode = LVLLNode<LVConnection*>;
+    /**
+     * @brief 从链表中移除连接,不删除连接
+     * @param connection
+     */
+    void remove(LVConnection * connection);
+
+    /**
+     * @brief 清空链表,不删除连接
+     */
+    void clear() { m_head = m_tail = nullptr; }
+};
 
 /**
  * 定义事件处理器
@@ -49,24 +79,41 @@ using SlotFunc = LVCallBack<void(LVSignal*),void>;
  */
 class LVConnection
 {
-    LV_MEMORY
+    LV_MEMORY_POOL(LVConnection,LV_CONNECTION_POOL_CHUNK)
 public:
     enum ConnectType : uint8_t
     {
         DirectConnect, //直接连接 立即调用槽对象
         QueueConnect, //队列连接 等待下次系统空闲时再来执行槽对象
+        CoalesceConnect, //合并的队列连接 执行前的多次发送只执行一次槽对象
+    };
+
+    /**
+     * @brief 连接在两端链表中的位置
+     */
+    enum LinkSide : uint8_t
+    {
+        SenderSide = 0,   //!< 在发送信号(m_signal0)的槽列表中
+        ReceiverSide = 1, //!< 在接收者(m_slot 或 m_signal1)的信号列表中
     };
 
     friend class LVSignal;
     friend class LVSlot;
+    friend class LVSignalQueue;
+    template<class... Args> friend class LVSignalT;
+    template<class... Args> friend class LVSlotT;
+    template<uint8_t Side> friend class LVConnectionList;
     friend LVConnection * connect(LVSignal *signal, LVSlot *slot, ConnectType type);
     friend LVConnection * connect(LVSignal *signal0, LVSignal *signal1, ConnectType type);
 
 protected:
     ConnectType m_type; //!< 连接的类型
+    bool m_typed = false; //!< 两端是相同参数的类型化信号槽,直接传递参数
+    uint32_t m_queued = 0; //!< 在派发队列中排队的次数,与队列长度同宽不会回绕
     LVSignal * m_signal0 = nullptr; //!< 信号1
     LVSignal * m_signal1 = nullptr; //!< 信号2
     LVSlot * m_slot = nullptr; //!< 槽
+    LVConnectionLink m_links[2]; //!< 嵌入的链表节点 [SenderSide,ReceiverSide]
 public:
     virtual ~LVConnection();
 protected:
@@ -77,9 +124,24 @@ protected:
 
     /**
      * @brief 执行这个连接,等效于执行连接的槽函数
+     * 队列连接会放入派发队列,稍后执行
      */
     void operator()();
 
+    /**
+     * @brief 立即执行连接的槽函数
+     */
+    void invoke();
+
+    /**
+     * @brief 是否在派发队列中等待执行
+     * @return
+     */
+    bool isQueued() const
+    {
+        return m_queued != 0;
+    }
+
     /**
      * @brief 检测信号是否是发送者
      * 如果是两个信号连接需要确定发送者和接收者
@@ -115,6 +177,61 @@ protected:
 };
 
 
+/**
+ *  槽对象列表(信号发出的连接)
+ */
+using LVSlotList = LVConnectionList<LVConnection::SenderSide>;
+
+/**
+ *  信号对象列表(连接到接收者的连接)
+ */
+using LVSignalList = LVConnectionList<LVConnection::ReceiverSide>;
+
+template<uint8_t Side>
+inline LVConnection * LVConnectionList<Side>::getNext(const LVConnection * connection)
+{
+    return connection->m_links[Side].next;
+}
+
+template<uint8_t Side>
+inline LVConnection * LVConnectionList<Side>::getPrev(const LVConnection * connection)
+{
+    return connection->m_links[Side].prev;
+}
+
+template<uint8_t Side>
+inline void LVConnectionList<Side>::insertTail(LVConnection * connection)
+{
+    LVConnectionLink & link = connection->m_links[Side];
+    link.prev = m_tail;
+    link.next = nullptr;
+    if(m_tail)
+        m_tail->m_links[Side].next = connection;
+    else
+        m_head = connection;
+    m_tail = connection;
+}
+
+template<uint8_t Side>
+inline void LVConnectionList<Side>::remove(LVConnection * connection)
+{
+    LVConnectionLink & link = connection->m_links[Side];
+    if(link.prev)
+        link.prev->m_links[Side].next = link.next;
+    else if(m_head == connection)
+        m_head = link.next;
+    else
+        return; //不在这个链表中
+
+    if(link.next)
+        link.next->m_links[Side].prev = link.prev;
+    else
+        m_tail = link.prev;
+
+    link.prev = nullptr;
+    link.next = nullptr;
+}
+
 LVConnection *connect(LVSignal * signal,LVSlot * slot,LVConnection::ConnectType type = LVConnection::DirectConnect);
 LVConnection *connect(LVSignal * signal0,LVSignal * signal1,LVConnection::ConnectType type = LVConnection::DirectConnect);
 
@@ -135,16 +252,16 @@ void disConnectAll(LVSlot * slot);
  */
 class LVSignal
 {
-    LV_MEMORY
+    LV_MEMORY_SLAB
 
     friend class LVConnection;
     friend class LVSlot;
 protected:
     void * m_param = nullptr; //!< 信号的参数(一个对象指针)
-    LVSlotList m_slotList; //!<与信号关联的槽对象列表
+    LVSlotList m_slotList; //!<与信号关联的槽对象列表(本信号发出的连接)
+    LVSignalList m_signalList; //!<连接到本信号的信号列表(本信号接收的连接)
 public:
     LVSignal()
-        :m_slotList(sizeof (LVConnection*))
     {}
 
     virtual ~LVSignal()
@@ -179,7 +296,7 @@ public:
 
     bool isConnected()
     {
-        return m_slotList.getHead() != nullptr;
+        return !m_slotList.isEmpty() || !m_signalList.isEmpty();
     }
 
     bool isConnectedBy(LVSignal * signal);
@@ -206,7 +323,7 @@ protected:
  */
 class LVSlot
 {
-    LV_MEMORY
+    LV_MEMORY_SLAB
 
     friend class LVConnection;
     friend class LVSignal;
@@ -215,12 +332,11 @@ protected:
     SlotFunc m_slotFunc; //!< 具体执行的槽函数
 public:
     LVSlot(const SlotFunc & slotFunc = SlotFunc(nullptr))
-        :m_signalList(sizeof (LVConnection*))
     {
         setSlotFunc(slotFunc);
     }
 
-    ~LVSlot()
+    virtual ~LVSlot()
     {
         disConnectAll();
     }
@@ -250,7 +366,7 @@ public:
 
     bool isConnected()
     {
-        return m_signalList.getHead() != nullptr;
+        return !m_signalList.isEmpty();
     }
 
     bool isConnectedBy(LVSignal * signal);
@@ -0,0 +1,137 @@
+#ifndef LVSIGNALSLOTT_H
+#define LVSIGNALSLOTT_H
+
+#include "LVSignalSlot.h"
+
+/**
+ * @brief 带参数类型的信号对象
+ * 参数在发送时直接传给槽函数,不经过 m_param,
+ * 在槽函数中再次发送同一个信号也不会覆盖参数.
+ *
+ * 与 LVSignal/LVSlot 共用同一套连接,可以混合连接:
+ * 参数类型相同的直接连接会传递参数,
+ * 其他连接(普通信号槽,队列连接)按 LVSignal 的方式执行,不带参数.
+ *
+ * 需要传引用时把引用写进参数类型,如 LVSignalT<const LVString &>
+ */
+template<class... Args>
+class LVSignalT : public LVSignal
+{
+    LV_MEMORY_SLAB
+
+    template<class... Other> friend class LVSignalT;
+public:
+    using SlotType = LVSlotT<Args...>;
+
+    LVSignalT() {}
+
+    using LVSignal::connect;
+
+    /**
+     * @brief 连接到参数相同的槽
+     * 只有直接连接能够传递参数
+     * @param slot
+     * @param type
+     * @return
+     */
+    LVConnection * connect(SlotType * slot,LVConnection::ConnectType type = LVConnection::DirectConnect)
+    {
+        LVConnection * connection = ::connect(this,static_cast<LVSlot *>(slot),type);
+        if(connection && type == LVConnection::DirectConnect)
+            connection->m_typed = true;
+        return connection;
+    }
+
+    /**
+     * @brief 连接到参数相同的信号,发送时转发参数
+     * @param signal
+     * @param type
+     * @return
+     */
+    LVConnection * connect(LVSignalT * signal,LVConnection::ConnectType type = LVConnection::DirectConnect)
+    {
+        LVConnection * connection = ::connect(this,static_cast<LVSignal *>(signal),type);
+        if(connection && type == LVConnection::DirectConnect)
+            connection->m_typed = true;
+        return connection;
+    }
+
+    /**
+     * @brief 发送信号,参数直接传给各个槽函数
+     * @param args
+     */
+    void emit(Args... args)
+    {
+        LVConnection * connection = m_slotList.getHead();
+        while (connection)
+        {
+            //先取出下一个连接,槽函数中可能会断开当前的连接
+            LVConnection * next = LVSlotList::getNext(connection);
+            if(connection->m_typed)
+            {
+                if(connection->m_slot)
+                    static_cast<SlotType *>(connection->m_slot)->invoke(args...);
+                else if(connection->m_signal1)
+                    static_cast<LVSignalT *>(connection->m_signal1)->emit(args...);
+            }
+            else
+            {
+                (*connection)();
+            }
+            connection = next;
+        }
+    }
+
+    void operator()(Args... args)
+    {
+        emit(args...);
+    }
+};
+
+/**
+ * @brief 带参数类型的槽对象
+ * 类型化的处理函数接收 LVSignalT 的参数,
+ * 普通的 SlotFunc 处理来自 LVSignal 或队列连接的调用
+ */
+template<class... Args>
+class LVSlotT : public LVSlot
+{
+    LV_MEMORY_SLAB
+
+public:
+    using SignalType = LVSignalT<Args...>;
+    using TypedFunc = LVCallBack<void(Args...),void>;
+
+protected:
+    TypedFunc m_typedFunc; //!< 带参数的槽函数
+
+public:
+    LVSlotT(const TypedFunc & typedFunc = TypedFunc(nullptr),const SlotFunc & slotFunc = SlotFunc(nullptr))
+        :LVSlot(slotFunc)
+        ,m_typedFunc(typedFunc)
+    {}
+
+    void setTypedFunc(const TypedFunc & typedFunc)
+    {
+        m_typedFunc = typedFunc;
+    }
+
+    using LVSlot::connect;
+
+    LVConnection * connect(SignalType * signal,LVConnection::ConnectType type = LVConnection::DirectConnect)
+    {
+        return signal ? signal->connect(this,type) : nullptr;
+    }
+
+    /**
+     * @brief 执行带参数的槽函数
+     * @param args
+     */
+    void invoke(Args... args)
+    {
+        if(m_typedFunc)
+            m_typedFunc(args...);
+    }
+};
+
+#endif // LVSIGNALSLOTT_H
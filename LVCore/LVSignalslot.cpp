@@ -1,5 +1,5 @@
 #include "LVSignalSlot.h"
-#include <LVMisc/LVTask.h>
+#include "LVSignalQueue.h"
 
 
 LVConnection * connect(LVSignal *signal, LVSlot *slot, LVConnection::ConnectType type)
@@ -8,6 +8,12 @@ LVConnection * connect(LVSignal *signal, LVSlot *slot, LVConnection::ConnectType
 }
 LVConnection * connect(LVSignal *signal0, LVSignal *signal1, LVConnection::ConnectType type)
 {
+    //信号连接到自身会无限递归,不创建没有信号持有的连接
+    if(signal0 == signal1)
+    {
+        lvWarn("connect : signal(0x%p) can not connect to itself.",signal0);
+        return nullptr;
+    }
     return new LVConnection(signal0,signal1,type);
 }
 
@@ -40,6 +46,9 @@ void disConnectAll(LVSignal *signal)
 
 LVConnection::~LVConnection()
 {
+    //从派发队列中撤销,避免执行已删除的连接
+    if(m_queued)
+        LVSignalQueue::getDefault()->cancel(this);
     if(m_signal0)
         m_signal0->removeConnection(this);
     if(m_signal1)
@@ -66,7 +75,8 @@ LVConnection::LVConnection(LVSignal *signal0, LVSignal *signal1, ConnectType typ
     ,m_signal1(signal1)
 
 {
-    if(isSignalSignalConnect())
+    //信号连接到自身会无限递归
+    if(isSignalSignalConnect() && m_signal0 != m_signal1)
     {
         m_signal0->addConnection(this);
         m_signal1->addConnection(this);
@@ -77,42 +87,45 @@ void LVConnection::operator()()
 {
     if(isvaild())
     {
-        if(isSignalSlotConnect())
+        if(m_type == DirectConnect)
         {
-            if(m_type == DirectConnect)
-                (*m_slot)(m_signal0);
-            else if(m_type == QueueConnect)
-                LVTask::once(1,[this](LVTask*){ (*m_slot)(m_signal0); }); //LVTaskCallBack::StdFunc(
+            invoke();
         }
-        else if(isSignalSignalConnect())
+        else
         {
-            if(m_type == DirectConnect)
-                (*m_signal1)(m_signal0);
-            else if(m_type == QueueConnect)
-                LVTask::once(1,[this](LVTask*){ (*m_signal1)(m_signal0); });//LVTaskCallBack::StdFunc(
+            LVSignalQueue * queue = LVSignalQueue::getDefault();
+            //合并连接已在队列中,这次发送不再排队
+            if(m_type == CoalesceConnect && m_queued)
+                ++queue->m_coalescedCount;
+            //无法排队时退化为直接执行
+            else if(!queue->enqueue(this))
+                invoke();
         }
     }
 }
 
+void LVConnection::invoke()
+{
+    if(isSignalSlotConnect())
+        (*m_slot)(m_signal0);
+    else if(isSignalSignalConnect())
+        (*m_signal1)(m_signal0);
+}
+
 void LVSignal::disConnect(LVSlot *slot)
 {
     if(slot)
     {
-        ConnectionNode * node = m_slotList.getHead();
-        while (node)
+        LVConnection * connection = m_slotList.getHead();
+        while (connection)
         {
-            LVConnection * connecttion = node->data();
-            if(connecttion->m_slot == slot) //connecttion &&
+            if(connection->m_slot == slot)
             {
-                connecttion->m_slot->removeConnection(connecttion);
-                connecttion->m_slot = nullptr;
-                connecttion->m_signal0 = nullptr;
-                m_slotList.remove(node);
-                delete connecttion;
+                //析构时会从两端的链表中移除
+                delete connection;
                 return;
             }
-            //执行连接
-            node = m_slotList.getNext(node);
+            connection = LVSlotList::getNext(connection);
         }
     }
 }
@@ -121,121 +134,87 @@ void LVSignal::disConnect(LVSignal *signal)
 {
     if(signal)
     {
-        ConnectionNode * node = m_slotList.getHead();
-        while (node)
+        //本信号连接到signal
+        LVConnection * connection = m_slotList.getHead();
+        while (connection)
+        {
+            if(connection->m_signal1 == signal)
+            {
+                delete connection;
+                return;
+            }
+            connection = LVSlotList::getNext(connection);
+        }
+
+        //signal连接到本信号
+        connection = m_signalList.getHead();
+        while (connection)
         {
-            LVConnection * connecttion = node->data();
-            //if(connecttion)
-            //{
-                if(connecttion->m_signal1 == signal)
-                {
-                    connecttion->m_signal1->removeConnection(connecttion);
-                    connecttion->m_signal1 = nullptr;
-                    connecttion->m_signal0 = nullptr;
-                    m_slotList.remove(node);
-                    delete connecttion;
-                }
-                else if(connecttion->m_signal0 == signal)
-                {
-                    connecttion->m_signal0->removeConnection(connecttion);
-                    connecttion->m_signal1 = nullptr;
-                    connecttion->m_signal0 = nullptr;
-                    m_slotList.remove(node);
-                    delete connecttion;
-                }
+            if(connection->m_signal0 == signal)
+            {
+                delete connection;
                 return;
-            //}
-            //执行连接
-            node = m_slotList.getNext(node);
+            }
+            connection = LVSignalList::getNext(connection);
         }
     }
 }
 
 void LVSignal::disConnectAll()
 {
-    ConnectionNode * node = m_slotList.getHead();
-    while (node)
-    {
-        LVConnection * connect = node->data();
-        //if(connect)
-        //{
-            if(connect->isSignalSlotConnect())
-            {
-                connect->m_slot->removeConnection(connect);
-                connect->m_signal0 = nullptr;
-                connect->m_slot = nullptr;
-            }
-            else if(connect->isSignalSignalConnect())
-            {
-                if(connect->isSender(this))
-                {
-                    connect->m_signal1->removeConnection(connect);
-                    connect->m_signal0 = nullptr;
-                    connect->m_signal1 = nullptr;
-                }
-                else
-                {
-                    connect->m_signal0->removeConnection(connect);
-                    connect->m_signal0 = nullptr;
-                    connect->m_signal1 = nullptr;
-                }
-            }
-            delete connect;
-        //}
-        node = m_slotList.getNext(node);
-    }
-    m_slotList.clear();
+    //析构时会从链表中移除,所以一直取链表头
+    while (LVConnection * connection = m_slotList.getHead())
+        delete connection;
+    while (LVConnection * connection = m_signalList.getHead())
+        delete connection;
 }
 
 void LVSignal::emit(void * param)
 {
     setParam(param);
-    ConnectionNode * node = m_slotList.getHead();
-    while (node)
+    LVConnection * connection = m_slotList.getHead();
+    while (connection)
     {
-        LVConnection * connecttion = node->data();
-        if(connecttion)
-            //执行连接
-            (*connecttion)();
-        node = m_slotList.getNext(node);
+        //先取出下一个连接,槽函数中可能会断开当前的连接
+        LVConnection * next = LVSlotList::getNext(connection);
+        //执行连接
+        (*connection)();
+        connection = next;
     }
 }
 
 bool LVSignal::isConnectedBy(LVSignal *signal)
 {
-    ConnectionNode * node = m_slotList.getHead();
-    while (node)
+    LVConnection * connection = m_signalList.getHead();
+    while (connection)
     {
-        LVConnection * connect = node->data();
-        if(signal == connect->m_signal0 && this == connect->m_signal1 )
+        if(signal == connection->m_signal0)
             return true;
-        node = m_slotList.getNext(node);
+        connection = LVSignalList::getNext(connection);
     }
     return false;
 }
 
 bool LVSignal::isConnectedTo(LVSignal *signal)
 {
-    ConnectionNode * node = m_slotList.getHead();
-    while (node)
+    LVConnection * connection = m_slotList.getHead();
+    while (connection)
     {
-        LVConnection * connect = node->data();
-        if(signal == connect->m_signal1 && this == connect->m_signal0 )
+        if(signal == connection->m_signal1)
             return true;
-        node = m_slotList.getNext(node);
+        connection = LVSlotList::getNext(connection);
     }
     return false;
 }
 
 bool LVSignal::isConnectedTo(LVSlot *slot)
 {
-    ConnectionNode * node = m_slotList.getHead();
-    while (node)
+    LVConnection * connection = m_slotList.getHead();
+    while (connection)
     {
-        LVConnection * connect = node->data();
-        if(slot == connect->m_slot && this == connect->m_signal0)
+        if(slot == connection->m_slot)
             return true;
-        node = m_slotList.getNext(node);
+        connection = LVSlotList::getNext(connection);
     }
     return false;
 }
@@ -245,75 +224,46 @@ void LVSignal::setParam(void *param)
     m_param = param;
 }
 
-void LVSignal::addConnection(LVConnection *connect)
+void LVSignal::addConnection(LVConnection *connection)
 {
-    ConnectionNode * newNode = m_slotList.insertTail();
-    newNode->data() = connect;
+    if(connection->m_signal0 == this)
+        m_slotList.insertTail(connection);
+    else if(connection->m_signal1 == this)
+        m_signalList.insertTail(connection);
 }
 
 void LVSignal::removeConnection(LVConnection *connection)
 {
-    ConnectionNode * node = m_slotList.getHead();
-    while (node)
-    {
-        LVConnection * connect = node->data();
-        if(connect == connection)
-        {
-            m_slotList.remove(node);
-            return;
-        }
-        node = m_slotList.getNext(node);
-    }
+    if(connection->m_signal0 == this)
+        m_slotList.remove(connection);
+    if(connection->m_signal1 == this)
+        m_signalList.remove(connection);
 }
 
 void LVSlot::disConnectAll()
 {
-    ConnectionNode * node = m_signalList.getHead();
-    while (node)
-    {
-        LVConnection * connect = node->data();
-        if(connect && connect->isSignalSlotConnect())
-        {
-            connect->m_signal0->removeConnection(connect);
-            connect->m_signal0 = nullptr;
-            connect->m_slot = nullptr;
-            delete connect;
-        }
-        node = m_signalList.getNext(node);
-    }
-    m_signalList.clear();
+    while (LVConnection * connection = m_signalList.getHead())
+        delete connection;
 }
 
 bool LVSlot::isConnectedBy(LVSignal *signal)
 {
-    ConnectionNode * node = m_signalList.getHead();
-    while (node)
+    LVConnection * connection = m_signalList.getHead();
+    while (connection)
     {
-        LVConnection * connect = node->data();
-        if(signal == connect->m_signal0 && this == connect->m_slot)
+        if(signal == connection->m_signal0)
             return true;
-        node = m_signalList.getNext(node);
+        connection = LVSignalList::getNext(connection);
     }
     return false;
 }
 
-void LVSlot::addConnection(LVConnection *connect)
+void LVSlot::addConnection(LVConnection *connection)
 {
-    ConnectionNode * newNode = m_signalList.insertTail();
-    newNode->data() = connect;
+    m_signalList.insertTail(connection);
 }
 
 void LVSlot::removeConnection(LVConnection *connection)
 {
-    ConnectionNode * node = m_signalList.getHead();
-    while (node)
-    {
-        LVConnection * connect = node->data();
-        if(connect == connection)
-        {
-            m_signalList.remove(node);
-            return;
-        }
-        node = m_signalList.getNext(node);
-    }
+    m_signalList.remove(connection);
 }
@@ -266,6 +266,78 @@ public:
      *     ENHANCE
      *******************/
 };
+
+/**
+ * @brief 只插值变化字段的样式动画
+ * LVStyleAnimation 每帧混合整个样式(lv_style_mix),再通知所有使用样式的对象刷新.
+ * 这里在设置样式时比较起止样式一次,只记录不同的字段,每帧只插值这些字段:
+ * - 本帧的值与上一帧相同时不做任何刷新
+ * - 只有颜色,透明度等绘制属性变化时,只重绘当前显示的使用这个样式的对象,
+ *   不发送 STYLE_CHG 信号,隐藏的对象和未显示的屏幕不刷新
+ * - 边距,字体,阴影宽度等影响布局的字段变化时,与 LVStyleAnimation 一样通知所有对象
+ *
+ * 与 LVAnimation 一样,动画结束后自动删除:
+ * LVStyleDiffAnimation * anim = new LVStyleDiffAnimation(&style,&normal,&highlight);
+ * anim->setTime(300,0);
+ */
+class LVStyleDiffAnimation
+        : public LVAnimation
+{
+    LV_MEMORY
+
+public:
+    //! 混合比例的最大值,与 lv_style_mix 相同
+    static constexpr uint16_t MIX_MAX = 256;
+
+protected:
+    LVStyle * m_target = nullptr;   //!< 动画的样式
+    LVStyle m_start;                //!< 起始样式的副本
+    LVStyle m_end;                  //!< 结束样式的副本
+    uint8_t m_fields[32];           //!< 变化的字段
+    uint8_t m_fieldCount = 0;       //!< 变化的字段数量
+
+public:
+    /**
+     * @param to_anim 动画的样式
+     * @param start 起始样式
+     * @param end 结束样式
+     */
+    LVStyleDiffAnimation(LVStyle * to_anim, const LVStyle * start, const LVStyle * end)
+        :LVAnimation()
+    {
+        setValues(0,MIX_MAX);
+        setStyles(to_anim,start,end);
+        setExecCallBack(execCallBack);
+    }
+
+    /**
+     * @brief 设置样式,比较起止样式,记录变化的字段
+     * @param to_anim 动画的样式
+     * @param start 起始样式
+     * @param end 结束样式
+     */
+    void setStyles(LVStyle * to_anim, const LVStyle * start, const LVStyle * end);
+
+    /**
+     * @brief 变化的字段数量
+     * @return
+     */
+    uint8_t changedFields() const { return m_fieldCount; }
+
+    /**
+     * @brief 按比例插值变化的字段并刷新对象
+     * @param ratio [0..MIX_MAX]
+     */
+    void apply(uint16_t ratio);
+
+protected:
+    static void execCallBack(LVAnimation * anim, LVAnimValue value);
+
+    /**
+     * @brief 重绘当前显示的使用样式的对象
+     */
+    static void invalidateUsers(const lv_style_t * style, lv_obj_t * obj);
+};
 #endif
 
 /*************************
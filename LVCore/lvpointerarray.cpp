@@ -0,0 +1,147 @@
+#include "lvpointerarray.h"
+
+LVPointerArrayBase::~LVPointerArrayBase()
+{
+    LVMemory::free(buffer_);
+    buffer_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+void LVPointerArrayBase::resize(uint32_t size)
+{
+    if(size > size_)
+    {
+        expand(size - size_);
+        memset(buffer_ + size_,0,(size - size_)*sizeof(void*));
+    }
+    size_ = size;
+}
+
+void LVPointerArrayBase::reserve(uint32_t size)
+{
+    if(size > capacity_)
+        reallocate(size);
+}
+
+void LVPointerArrayBase::squeeze()
+{
+    if(capacity_ > size_)
+        reallocate(size_);
+}
+
+void LVPointerArrayBase::removeAt(uint32_t pos)
+{
+    if(pos >= size_)
+        abort("LVPointerArray::removeAt index out-of-bounds");
+    --size_;
+    memmove(buffer_ + pos,buffer_ + pos + 1,(size_ - pos)*sizeof(void*));
+}
+
+void LVPointerArrayBase::removeAtFast(uint32_t pos)
+{
+    if(pos >= size_)
+        abort("LVPointerArray::removeAtFast index out-of-bounds");
+    buffer_[pos] = buffer_[--size_];
+}
+
+void LVPointerArrayBase::grow(uint32_t size)
+{
+    uint32_t capacity = capacity_ ? capacity_ : 4;
+    while (capacity < size)
+        capacity *= 2;
+    reallocate(capacity);
+}
+
+void LVPointerArrayBase::reallocate(uint32_t capacity)
+{
+    if(capacity == 0)
+    {
+        LVMemory::free(buffer_);
+        buffer_ = nullptr;
+    }
+    else
+    {
+        void * * buffer = static_cast<void**>(LVMemory::reallocate(buffer_,capacity*sizeof(void*)));
+        if(buffer == nullptr)
+            abort("LVPointerArray out of memory");
+        buffer_ = buffer;
+    }
+    capacity_ = capacity;
+}
+
+void LVPointerArrayBase::copy(const LVPointerArrayBase &other)
+{
+    size_ = 0;
+    reserve(other.size_);
+    if(other.size_)
+        memcpy(buffer_,other.buffer_,other.size_*sizeof(void*));
+    size_ = other.size_;
+}
+
+void LVPointerArrayBase::move(LVPointerArrayBase &other)
+{
+    LVMemory::free(buffer_);
+    buffer_ = other.buffer_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.buffer_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+}
+
+void LVPointerArrayBase::insertAt(const void *ptr, uint32_t pos)
+{
+    expand(1);
+    //向后挪动数据
+    memmove(buffer_ + pos + 1,buffer_ + pos,(size_ - pos)*sizeof(void*));
+    buffer_[pos] = const_cast<void*>(ptr);
+    ++size_;
+}
+
+int32_t LVPointerArrayBase::find(const void *ptr, uint32_t from) const
+{
+    void * const * data = buffer_;
+    uint32_t i = from;
+
+    //4个一组比较,没有分支依赖,便于编译器生成向量指令
+    for (; i + 4 <= size_; i += 4)
+    {
+        bool hit = (data[i] == ptr) | (data[i+1] == ptr) | (data[i+2] == ptr) | (data[i+3] == ptr);
+        if(hit)
+            break;
+    }
+    for (; i < size_; ++i)
+    {
+        if(data[i] == ptr)
+            return i;
+    }
+    return -1;
+}
+
+bool LVPointerArrayBase::findSorted(const void *ptr, uint32_t &pos) const
+{
+    uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+    uint32_t low = 0;
+    uint32_t high = size_;
+    while (low < high)
+    {
+        uint32_t mid = (low + high) >> 1;
+        if(reinterpret_cast<uintptr_t>(buffer_[mid]) < key)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    pos = low;
+    return low < size_ && buffer_[low] == ptr;
+}
+
+void LVPointerArrayBase::sortAddress()
+{
+    qsort(buffer_,size_,sizeof(void*),[](const void * a,const void * b) -> int
+    {
+        uintptr_t l = reinterpret_cast<uintptr_t>(*static_cast<void * const *>(a));
+        uintptr_t r = reinterpret_cast<uintptr_t>(*static_cast<void * const *>(b));
+        return l < r ? -1 : (l > r ? 1 : 0);
+    });
+}
@@ -9,92 +9,140 @@
 
 /**
  * @brief 指针数组基类
+ * 与类型无关的实现,所有模板实例共用同一份代码.
+ * 容量按2倍增长,内存经 LVMemory 分配.
  */
 class LVPointerArrayBase
 {
 protected:
-    size_t size_ = 0;
+    uint32_t size_ = 0;
+    uint32_t capacity_ = 0;
     void* * buffer_ = nullptr;
 
-    void abort(const char * mesg = "")
+    void abort(const char * mesg = "") const
     {
         lvError("LVPointerArray(%p) - %s",this,mesg);
         while (1) {}
     }
 public:
     LVPointerArrayBase(){}
+    ~LVPointerArrayBase();
 
     /**
      * @brief 能够存储指针的能力大小
      * @return
      */
-    inline uint32_t capacity() const { bufferSize()/sizeof(void*);}
+    inline uint32_t capacity() const { return capacity_;}
 
     /**
      * @brief 已经存储的指针个数
      * @return
      */
-    inline uint32_t size(){ return size_;}
+    inline uint32_t size() const { return size_;}
+
+    inline bool isEmpty() const { return size_ == 0;}
 
     /**
-     * @brief 重置指针容量大小
+     * @brief 重置指针个数,新增的位置为nullptr
      * @param size
      */
-    void resize(uint32_t size)
-    {
-        if(size > capacity())
-        {
-            buffer_ = lv_mem_realloc(buffer_,size*sizeof(void*));
-            memset(buffer_+size_,0,bufferSize()-size_*sizeof(void*));
-        }
-        else
-        {
-            memset(buffer_+size,0,bufferSize()-size*sizeof(void*));
-        }
-        size_ = size;
-    }
+    void resize(uint32_t size);
+
+    /**
+     * @brief 预留容量,之后添加不再重新分配
+     * @param size 指针个数
+     */
+    void reserve(uint32_t size);
+
+    /**
+     * @brief 释放多余的容量
+     */
+    void squeeze();
+
+    /**
+     * @brief 清空指针,保留容量
+     */
+    void clear() { size_ = 0; }
+
+    /**
+     * @brief 删除一个位置的指针,后面的向前移动
+     * @param pos
+     */
+    void removeAt(uint32_t pos);
+
+    /**
+     * @brief 删除一个位置的指针,用最后一个指针填补,不保持顺序
+     * @param pos
+     */
+    void removeAtFast(uint32_t pos);
+
 protected:
 
     /**
      * @brief 缓冲的字节数大小
      * @return
      */
-    inline uint32_t bufferSize() { lv_mem_get_size(buffer_); }
+    inline uint32_t bufferSize() const { return capacity_*sizeof(void*); }
 
     /**
      * @brief 扩大指针数组容量大小
      * @param size 扩大指针容量个数
      */
-    void expand(uint32_t size)
+    inline void expand(uint32_t size)
     {
-        uint32_t new_size = (size_+size)*sizeof(void*); //容器需要的字节数
-        if(bufferSize() < new_size)
-        {
-            buffer_ = lv_mem_realloc(buffer_,new_size);
-            memset(buffer_+size_,0,bufferSize()-size_*sizeof(void*));
-        }
+        if(size_ + size > capacity_)
+            grow(size_ + size);
     }
 
     /**
-     * @brief 缩小指针数组容量大小
-     * @param size 减少指针容量个数
+     * @brief 按2倍重新分配容量
+     * @param size 至少需要的指针个数
      */
-    void shrink(uint32_t size)
-    {
-        uint32_t new_size = (size_-size)*sizeof(void*); //容器需要的字节数
-        if(bufferSize() > new_size)
-        {
-            buffer_ = lv_mem_realloc(buffer_,new_size);
-            memset(buffer_+(size_-size),0,bufferSize()-new_size);
-        }
+    void grow(uint32_t size);
 
-        if(size<size_)
-            size_ = size;
-    }
+    /**
+     * @brief 重新分配为指定容量
+     * @param capacity
+     */
+    void reallocate(uint32_t capacity);
+
+    void copy(const LVPointerArrayBase & other);
+    void move(LVPointerArrayBase & other);
+
+    void insertAt(const void * ptr,uint32_t pos);
+
+    /**
+     * @brief 查找指针的位置
+     * 每次比较4个指针,较大的数组可以被编译器向量化
+     * @param ptr
+     * @param from 开始查找的位置
+     * @return 没有找到返回-1
+     */
+    int32_t find(const void * ptr,uint32_t from = 0) const;
+
+    /**
+     * @brief 在按地址升序的数组中二分查找
+     * @param ptr
+     * @param pos 返回指针应该所在的位置
+     * @return 是否找到
+     */
+    bool findSorted(const void * ptr,uint32_t & pos) const;
+
+    /**
+     * @brief 按地址升序排列
+     */
+    void sortAddress();
+
+private:
+    LVPointerArrayBase(const LVPointerArrayBase&) = delete;
+    LVPointerArrayBase& operator = (const LVPointerArrayBase&) = delete;
 };
 
 /**
  * @brief 指针数组
+ * 可以作为普通数组使用(append/indexOf),
+ * 也可以作为按地址排序的集合使用(insertSorted/containsSorted),
+ * 两种方式不要混用在同一个数组上.
  */
 template<class T>
 class LVPointerArray : public LVPointerArrayBase
@@ -103,70 +151,144 @@ class LVPointerArray : public LVPointerArrayBase
 
 public:
     typedef T* ptr_type;
-
-private:
-
+    typedef T** iterator;
+    typedef T* const * const_iterator;
 
 public:
 
     LVPointerArray()
     {}
-    LVPointerArray(size_t size)
+    LVPointerArray(uint32_t size)
     {
-        expand(size);
+        reserve(size);
     }
     LVPointerArray(const LVPointerArray & other)
     {
-        expand(other.size_ - size_);
-        memcpy(buffer_,other.buffer_,other.size_*sizeof(ptr_type));
-        size_ = other.size_;
+        copy(other);
     }
     LVPointerArray(LVPointerArray && other)
     {
-        buffer_ = other.buffer_;
-        size_ = other.size_;
-        other.buffer_ = nullptr;
-        other.size_ = 0;
+        move(other);
+    }
+
+    LVPointerArray & operator = (const LVPointerArray & other)
+    {
+        if(this != &other)
+            copy(other);
+        return *this;
+    }
+    LVPointerArray & operator = (LVPointerArray && other)
+    {
+        if(this != &other)
+            move(other);
+        return *this;
     }
-    ~LVPointerArray()
+
+    ptr_type at(uint32_t pos) const
     {
-        lv_mem_free(buffer_);
-        size_ = 0;
+        if(pos >= size_)
+            abort("LVPointerArray::at index out-of-bounds");
+        return static_cast<ptr_type>(buffer_[pos]);
     }
+    ptr_type operator [] (uint32_t pos) const { return at(pos); }
+    ptr_type & operator [] (uint32_t pos)
+    {
+        if(pos >= size_)
+            abort("LVPointerArray::operator [] index out-of-bounds");
+        return reinterpret_cast<ptr_type &>(buffer_[pos]);
+    }
+
+    ptr_type first() const { return at(0); }
+    ptr_type last() const { return at(size_ - 1); }
 
     void append(T * ptr)
     {
         expand(1);
-        buffer_[size_] = ptr;
-        size_ += 1;
+        buffer_[size_++] = ptr;
     }
 
     void prepend(T * ptr)
     {
-        expand(1);
-        //向后挪动数据
-        for (int i = size_; i > 0; --i) {
-            buffer_[i] = buffer_[i-1];
-        }
-        buffer_[0] = ptr;
-        size_ += 1;
+        insertAt(ptr,0);
     }
 
-    void insert(T * ptr,int pos)
+    void insert(T * ptr,uint32_t pos)
     {
-        if(pos == 0)
-            prepend(ptr);
-        else if(pos == size_)
-            append(ptr);
-        else if(pos>0 && pos<size_)
-        {
-            //TODO:插入数据
-        }
+        if(pos > size_)
+            abort("LVPointerArray::insert index out-of-bounds");
+        insertAt(ptr,pos);
     }
 
-private:
+    int32_t indexOf(const T * ptr,uint32_t from = 0) const { return find(ptr,from); }
+    bool contains(const T * ptr) const { return find(ptr) >= 0; }
 
+    /**
+     * @brief 删除第一个相同的指针
+     * @param ptr
+     * @return 是否删除
+     */
+    bool removeOne(const T * ptr)
+    {
+        int32_t pos = find(ptr);
+        if(pos < 0)
+            return false;
+        removeAt(pos);
+        return true;
+    }
+
+    ptr_type takeAt(uint32_t pos)
+    {
+        ptr_type ptr = at(pos);
+        removeAt(pos);
+        return ptr;
+    }
+
+    ////////////// 按地址排序的集合 ///////////////
+
+    /**
+     * @brief 按地址升序插入,已存在时不插入
+     * @param ptr
+     * @return 是否插入
+     */
+    bool insertSorted(T * ptr)
+    {
+        uint32_t pos;
+        if(findSorted(ptr,pos))
+            return false;
+        insertAt(ptr,pos);
+        return true;
+    }
+
+    int32_t indexOfSorted(const T * ptr) const
+    {
+        uint32_t pos;
+        return findSorted(ptr,pos) ? (int32_t)pos : -1;
+    }
+
+    bool containsSorted(const T * ptr) const
+    {
+        uint32_t pos;
+        return findSorted(ptr,pos);
+    }
+
+    bool removeSorted(const T * ptr)
+    {
+        uint32_t pos;
+        if(!findSorted(ptr,pos))
+            return false;
+        removeAt(pos);
+        return true;
+    }
+
+    /**
+     * @brief 把普通数组整理成按地址排序的集合
+     */
+    void sort() { sortAddress(); }
 
+    iterator begin() { return reinterpret_cast<iterator>(buffer_); }
+    iterator end() { return reinterpret_cast<iterator>(buffer_) + size_; }
+    const_iterator begin() const { return reinterpret_cast<const_iterator>(buffer_); }
+    const_iterator end() const { return reinterpret_cast<const_iterator>(buffer_) + size_; }
 };
 
 #endif // LVPOINTERARRAY_H
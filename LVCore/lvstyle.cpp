@@ -15,3 +15,232 @@ const LVStyle & LVStyle::btn_tgl_pr   = *(static_cast<LVStyle*>(&lv_style_btn_tg
 const LVStyle & LVStyle::btn_ina      = *(static_cast<LVStyle*>(&lv_style_btn_ina     )) ;
 
 LVStyle LVStyle::none = LVStyle::pretty;
+
+#if LV_USE_ANIMATION
+
+#include <stddef.h>
+
+namespace
+{
+/**
+ * 样式字段的插值方式
+ */
+enum StyleFieldKind : uint8_t
+{
+    FIELD_COORD,  //!< lv_coord_t,线性插值
+    FIELD_OPA,    //!< lv_opa_t,线性插值
+    FIELD_COLOR,  //!< lv_color_t,颜色混合
+    FIELD_SWITCH, //!< 不能插值,过半时切换
+    FIELD_GLASS,  //!< 位域 glass,过半时切换
+    FIELD_ROUNDED,//!< 位域 line.rounded,过半时切换
+};
+
+struct StyleField
+{
+    uint8_t offset;
+    uint8_t size;
+    StyleFieldKind kind;
+    bool layout; //!< 影响对象大小或布局,需要发送 STYLE_CHG 信号
+};
+
+#define STYLE_FIELD(member,kind,layout) \
+    { (uint8_t)offsetof(lv_style_t,member), (uint8_t)sizeof(lv_style_t::member), kind, layout }
+
+const StyleField s_styleFields[] =
+{
+    { 0, 0, FIELD_GLASS, false },
+    STYLE_FIELD(body.main_color,      FIELD_COLOR,  false),
+    STYLE_FIELD(body.grad_color,      FIELD_COLOR,  false),
+    STYLE_FIELD(body.radius,          FIELD_COORD,  false),
+    STYLE_FIELD(body.opa,             FIELD_OPA,    false),
+    STYLE_FIELD(body.border.color,    FIELD_COLOR,  false),
+    STYLE_FIELD(body.border.width,    FIELD_COORD,  false),
+    STYLE_FIELD(body.border.part,     FIELD_SWITCH, false),
+    STYLE_FIELD(body.border.opa,      FIELD_OPA,    false),
+    STYLE_FIELD(body.shadow.color,    FIELD_COLOR,  false),
+    STYLE_FIELD(body.shadow.width,    FIELD_COORD,  true),
+    STYLE_FIELD(body.shadow.type,     FIELD_SWITCH, true),
+    STYLE_FIELD(body.padding.top,     FIELD_COORD,  true),
+    STYLE_FIELD(body.padding.bottom,  FIELD_COORD,  true),
+    STYLE_FIELD(body.padding.left,    FIELD_COORD,  true),
+    STYLE_FIELD(body.padding.right,   FIELD_COORD,  true),
+    STYLE_FIELD(body.padding.inner,   FIELD_COORD,  true),
+    STYLE_FIELD(text.color,           FIELD_COLOR,  false),
+    STYLE_FIELD(text.sel_color,       FIELD_COLOR,  false),
+    STYLE_FIELD(text.font,            FIELD_SWITCH, true),
+    STYLE_FIELD(text.letter_space,    FIELD_COORD,  true),
+    STYLE_FIELD(text.line_space,      FIELD_COORD,  true),
+    STYLE_FIELD(text.opa,             FIELD_OPA,    false),
+    STYLE_FIELD(image.color,          FIELD_COLOR,  false),
+    STYLE_FIELD(image.intense,        FIELD_OPA,    false),
+    STYLE_FIELD(image.opa,            FIELD_OPA,    false),
+    STYLE_FIELD(line.color,           FIELD_COLOR,  false),
+    STYLE_FIELD(line.width,           FIELD_COORD,  true),
+    STYLE_FIELD(line.opa,             FIELD_OPA,    false),
+    { 0, 0, FIELD_ROUNDED, false },
+};
+
+#undef STYLE_FIELD
+
+constexpr uint8_t STYLE_FIELD_NUM = sizeof(s_styleFields) / sizeof(s_styleFields[0]);
+}
+
+void LVStyleDiffAnimation::setStyles(LVStyle *to_anim, const LVStyle *start, const LVStyle *end)
+{
+    static_assert(STYLE_FIELD_NUM <= sizeof(m_fields),"too many style fields");
+
+    m_target = to_anim;
+    m_start = *start;
+    m_end = *end;
+
+    //只比较一次,记录不同的字段
+    m_fieldCount = 0;
+    const uint8_t * s = reinterpret_cast<const uint8_t *>(static_cast<const lv_style_t *>(&m_start));
+    const uint8_t * e = reinterpret_cast<const uint8_t *>(static_cast<const lv_style_t *>(&m_end));
+    for (uint8_t i = 0; i < STYLE_FIELD_NUM; ++i)
+    {
+        const StyleField & f = s_styleFields[i];
+        bool diff;
+        if(f.kind == FIELD_GLASS)
+            diff = m_start.glass != m_end.glass;
+        else if(f.kind == FIELD_ROUNDED)
+            diff = m_start.line.rounded != m_end.line.rounded;
+        else
+            diff = memcmp(s + f.offset,e + f.offset,f.size) != 0;
+        if(diff)
+            m_fields[m_fieldCount++] = i;
+    }
+
+    //相同的字段之后不再写入,先整体复制开始样式(同 lv_style_anim_set_styles)
+    if(m_target)
+    {
+        *static_cast<lv_style_t *>(m_target) = *static_cast<const lv_style_t *>(start);
+        lv_obj_report_style_mod(m_target);
+    }
+}
+
+void LVStyleDiffAnimation::apply(uint16_t ratio)
+{
+    if(m_target == nullptr)
+        return;
+    if(ratio > MIX_MAX)
+        ratio = MIX_MAX;
+
+    const uint8_t * s = reinterpret_cast<const uint8_t *>(static_cast<const lv_style_t *>(&m_start));
+    const uint8_t * e = reinterpret_cast<const uint8_t *>(static_cast<const lv_style_t *>(&m_end));
+    uint8_t * t = reinterpret_cast<uint8_t *>(static_cast<lv_style_t *>(m_target));
+
+    bool changed = false;
+    bool layout = false;
+    for (uint8_t i = 0; i < m_fieldCount; ++i)
+    {
+        const StyleField & f = s_styleFields[m_fields[i]];
+        const uint8_t * sv = s + f.offset;
+        const uint8_t * ev = e + f.offset;
+        uint8_t * tv = t + f.offset;
+
+        switch (f.kind)
+        {
+        case FIELD_COORD:
+        {
+            lv_coord_t a, b, v, old;
+            memcpy(&a,sv,sizeof(a));
+            memcpy(&b,ev,sizeof(b));
+            memcpy(&old,tv,sizeof(old));
+            v = a + (((int32_t)(b - a) * ratio) >> 8);
+            if(v == old)
+                continue;
+            memcpy(tv,&v,sizeof(v));
+            break;
+        }
+        case FIELD_OPA:
+        {
+            lv_opa_t v = *sv + (((int32_t)(*ev - *sv) * ratio) >> 8);
+            if(v == *tv)
+                continue;
+            *tv = v;
+            break;
+        }
+        case FIELD_COLOR:
+        {
+            lv_color_t a, b, v;
+            memcpy(&a,sv,sizeof(a));
+            memcpy(&b,ev,sizeof(b));
+            v = ratio >= MIX_MAX ? b : lv_color_mix(b,a,(uint8_t)ratio);
+            if(memcmp(&v,tv,sizeof(v)) == 0)
+                continue;
+            memcpy(tv,&v,sizeof(v));
+            break;
+        }
+        case FIELD_GLASS:
+        {
+            uint8_t v = ratio < (MIX_MAX >> 1) ? m_start.glass : m_end.glass;
+            if(v == m_target->glass)
+                continue;
+            m_target->glass = v;
+            break;
+        }
+        case FIELD_ROUNDED:
+        {
+            uint8_t v = ratio < (MIX_MAX >> 1) ? m_start.line.rounded : m_end.line.rounded;
+            if(v == m_target->line.rounded)
+                continue;
+            m_target->line.rounded = v;
+            break;
+        }
+        default:
+        {
+            const uint8_t * v = ratio < (MIX_MAX >> 1) ? sv : ev;
+            if(memcmp(v,tv,f.size) == 0)
+                continue;
+            memcpy(tv,v,f.size);
+            break;
+        }
+        }
+
+        changed = true;
+        layout |= f.layout;
+    }
+
+    if(!changed)
+        return;
+
+    if(layout)
+    {
+        //大小和布局可能变化,所有使用样式的对象都要重新计算
+        lv_obj_report_style_mod(m_target);
+    }
+    else
+    {
+        //只是外观变化,重绘正在显示的对象
+        for (lv_disp_t * disp = lv_disp_get_next(nullptr); disp; disp = lv_disp_get_next(disp))
+        {
+            invalidateUsers(m_target,lv_disp_get_scr_act(disp));
+            invalidateUsers(m_target,lv_disp_get_layer_top(disp));
+            invalidateUsers(m_target,lv_disp_get_layer_sys(disp));
+        }
+    }
+}
+
+void LVStyleDiffAnimation::execCallBack(LVAnimation *anim, LVAnimValue value)
+{
+    static_cast<LVStyleDiffAnimation *>(anim)->apply((uint16_t)value);
+}
+
+void LVStyleDiffAnimation::invalidateUsers(const lv_style_t *style, lv_obj_t *obj)
+{
+    if(obj == nullptr || lv_obj_get_hidden(obj))
+        return;
+
+    //重绘对象的区域已包含子对象
+    if(obj->style_p == style)
+    {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    for (lv_obj_t * child = lv_obj_get_child(obj,nullptr); child; child = lv_obj_get_child(obj,child))
+        invalidateUsers(style,child);
+}
+
+#endif // LV_USE_ANIMATION
@@ -0,0 +1,153 @@
+#include "LVAnimPath.h"
+
+#if LV_USE_ANIMATION
+
+static_assert(LV_ANIM_PATH_LUT_BITS <= 10,"LV_ANIM_PATH_LUT_BITS must not exceed the bezier resolution");
+
+namespace
+{
+/**
+ * @brief 内置路径的曲线,以 LV_ANIM_PATH_VALUE_MAX 为结束值
+ */
+int32_t curve(LVAnimPath::Path path, uint32_t t)
+{
+    if(path == LVAnimPath::PATH_BOUNCE)
+    {
+        int32_t div;
+        int32_t fall = LVAnimPath::bounceCurve(t,div);
+        return LV_ANIM_PATH_VALUE_MAX - fall * (LV_ANIM_PATH_VALUE_MAX >> 10) / div;
+    }
+    return LVAnimPath::ease(path,t) * (LV_ANIM_PATH_VALUE_MAX >> 10);
+}
+
+/**
+ * @brief 内置路径的表,第一次使用时生成
+ */
+const LVAnimPathTable * builtinTables()
+{
+    static LVAnimPathTable s_tables[LVAnimPath::PATH_STEP - LVAnimPath::PATH_EASE_IN];
+    static bool s_ready = false;
+    if(!s_ready)
+    {
+        for (uint8_t p = LVAnimPath::PATH_EASE_IN; p < LVAnimPath::PATH_STEP; ++p)
+        {
+            LVAnimPathTable & table = s_tables[p - LVAnimPath::PATH_EASE_IN];
+            for (uint32_t i = 0; i <= LV_ANIM_PATH_LUT_SIZE; ++i)
+                table.m_value[i] = (int16_t)curve((LVAnimPath::Path)p,(i << 10) >> LV_ANIM_PATH_LUT_BITS);
+            table.m_value[LV_ANIM_PATH_LUT_SIZE + 1] = table.m_value[LV_ANIM_PATH_LUT_SIZE];
+        }
+        s_ready = true;
+    }
+    return s_tables;
+}
+
+/**
+ * 贝塞尔曲线的一个分量,起点0,终点1
+ */
+inline float bezierAxis(float t, float p1, float p2)
+{
+    float r = 1.0f - t;
+    return 3.0f * r * r * t * p1 + 3.0f * r * t * t * p2 + t * t * t;
+}
+
+inline uint32_t progressOf(const lv_anim_t * a)
+{
+    if(a->act_time >= (int32_t)a->time)
+        return LV_ANIM_PATH_PROGRESS_MAX;
+    return ((uint32_t)a->act_time << LV_ANIM_PATH_PROGRESS_SHIFT) / a->time;
+}
+}
+
+const LVAnimPathTable *LVAnimPath::table(LVAnimPath::Path path)
+{
+    if(path <= PATH_LINEAR || path >= PATH_STEP)
+        return nullptr;
+    return &builtinTables()[path - PATH_EASE_IN];
+}
+
+void LVAnimPath::bake(LVAnimPathTable &table, float x1, float y1, float x2, float y2)
+{
+    //x1,x2 在 [0,1] 内时 x(t) 单调,二分求解
+    if(x1 < 0.0f) x1 = 0.0f;
+    if(x1 > 1.0f) x1 = 1.0f;
+    if(x2 < 0.0f) x2 = 0.0f;
+    if(x2 > 1.0f) x2 = 1.0f;
+
+    for (uint32_t i = 0; i <= LV_ANIM_PATH_LUT_SIZE; ++i)
+    {
+        float x = float(i) / LV_ANIM_PATH_LUT_SIZE;
+        float lo = 0.0f;
+        float hi = 1.0f;
+        for (uint8_t n = 0; n < 20; ++n)
+        {
+            float mid = (lo + hi) * 0.5f;
+            if(bezierAxis(mid,x1,x2) < x)
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        float y = bezierAxis((lo + hi) * 0.5f,y1,y2) * LV_ANIM_PATH_VALUE_MAX;
+        if(y > INT16_MAX)
+            y = INT16_MAX;
+        if(y < INT16_MIN)
+            y = INT16_MIN;
+        table.m_value[i] = (int16_t)(y < 0 ? y - 0.5f : y + 0.5f);
+    }
+    table.m_value[0] = 0;
+    table.m_value[LV_ANIM_PATH_LUT_SIZE] = LV_ANIM_PATH_VALUE_MAX;
+    table.m_value[LV_ANIM_PATH_LUT_SIZE + 1] = LV_ANIM_PATH_VALUE_MAX;
+}
+
+lv_anim_value_t LVAnimPath::evaluate(const LVAnimPathTable &table, const lv_anim_t *a)
+{
+    return evaluate(table,a,progressOf(a));
+}
+
+lv_anim_value_t LVAnimPath::easeIn(const lv_anim_t *a)
+{
+    return evaluate(builtinTables()[PATH_EASE_IN - PATH_EASE_IN],a);
+}
+
+lv_anim_value_t LVAnimPath::easeOut(const lv_anim_t *a)
+{
+    return evaluate(builtinTables()[PATH_EASE_OUT - PATH_EASE_IN],a);
+}
+
+lv_anim_value_t LVAnimPath::easeInOut(const lv_anim_t *a)
+{
+    return evaluate(builtinTables()[PATH_EASE_IN_OUT - PATH_EASE_IN],a);
+}
+
+lv_anim_value_t LVAnimPath::overShoot(const lv_anim_t *a)
+{
+    return evaluate(builtinTables()[PATH_OVERSHOOT - PATH_EASE_IN],a);
+}
+
+lv_anim_value_t LVAnimPath::bounce(const lv_anim_t *a)
+{
+    return evaluate(builtinTables()[PATH_BOUNCE - PATH_EASE_IN],a);
+}
+
+lv_anim_path_cb_t LVAnimPath::callBack(LVAnimPath::Path path)
+{
+    switch (path)
+    {
+    case PATH_EASE_IN:
+        return easeIn;
+    case PATH_EASE_OUT:
+        return easeOut;
+    case PATH_EASE_IN_OUT:
+        return easeInOut;
+    case PATH_OVERSHOOT:
+        return overShoot;
+    case PATH_BOUNCE:
+        return bounce;
+    case PATH_STEP:
+        return lv_anim_path_step;
+    default:
+        return lv_anim_path_linear;
+    }
+}
+
+#endif // LV_USE_ANIMATION
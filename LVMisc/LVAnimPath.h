@@ -0,0 +1,281 @@
+/**
+ * @file LVAnimPath.h
+ *
+ */
+
+#ifndef LVANIMPATH_H
+#define LVANIMPATH_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lv_misc/lv_anim.h>
+
+#if LV_USE_ANIMATION
+
+#include "LVMemory.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 路径表的精度,表中有 2^LV_ANIM_PATH_LUT_BITS 段
+ */
+#ifndef LV_ANIM_PATH_LUT_BITS
+#define LV_ANIM_PATH_LUT_BITS 7
+#endif
+
+#define LV_ANIM_PATH_LUT_SIZE   (1 << LV_ANIM_PATH_LUT_BITS)
+
+/**
+ * 进度的定点精度,[0,1<<16]
+ */
+#define LV_ANIM_PATH_PROGRESS_SHIFT 16
+#define LV_ANIM_PATH_PROGRESS_MAX   (1 << LV_ANIM_PATH_PROGRESS_SHIFT)
+
+/**
+ * 表中数值的定点精度,4096 表示结束值
+ */
+#define LV_ANIM_PATH_VALUE_SHIFT 12
+#define LV_ANIM_PATH_VALUE_MAX   (1 << LV_ANIM_PATH_VALUE_SHIFT)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @brief 动画路径的查找表
+ * 把进度 [0,LV_ANIM_PATH_PROGRESS_MAX] 映射为曲线值,段内线性插值,
+ * 没有分支和除法.
+ * 最后多存一个结束值,进度为最大值时插值不越界.
+ */
+struct LVAnimPathTable
+{
+    LV_MEMORY
+
+public:
+    int16_t m_value[LV_ANIM_PATH_LUT_SIZE + 2];
+
+    constexpr LVAnimPathTable()
+        : m_value{}
+    {}
+
+    /**
+     * @brief 曲线值
+     * @param progress [0,LV_ANIM_PATH_PROGRESS_MAX]
+     * @return 以 LV_ANIM_PATH_VALUE_MAX 为结束值
+     */
+    inline int32_t at(uint32_t progress) const
+    {
+        constexpr uint32_t shift = LV_ANIM_PATH_PROGRESS_SHIFT - LV_ANIM_PATH_LUT_BITS;
+        uint32_t i = progress >> shift;
+        int32_t frac = progress & ((1 << shift) - 1);
+        int32_t v0 = m_value[i];
+        return v0 + (((m_value[i + 1] - v0) * frac) >> shift);
+    }
+};
+
+/**
+ * @brief 查表实现的动画路径
+ * 内置的缓动曲线在第一次使用时生成,表中的点与 lv_anim_path_xxx 相同;
+ * 自定义的三次贝塞尔曲线(与CSS的 cubic-bezier 相同)在设置时烘焙成表.
+ * 静态函数可以直接作为 lv_anim_path_cb_t 使用.
+ *
+ * LVAnimation 缓存时长的倒数,每帧的计算不需要除法:
+ * anim->setPath(LVAnimPath::PATH_EASE_OUT);
+ * anim->setPathBezier(0.25f,0.1f,0.25f,1.0f);
+ */
+class LVAnimPath
+{
+public:
+    /**
+     * @brief 内置的动画路径
+     */
+    enum Path : uint8_t
+    {
+        PATH_LINEAR,
+        PATH_EASE_IN,
+        PATH_EASE_OUT,
+        PATH_EASE_IN_OUT,
+        PATH_OVERSHOOT,
+        PATH_BOUNCE,
+        PATH_STEP,
+        _PATH_NUM,
+    };
+
+    /**
+     * @brief 与 lv_bezier3 相同的定点计算,内联后可以在循环中向量化
+     * @param t [0,1024]
+     * @param u0 起点
+     * @param u1 控制点1
+     * @param u2 控制点2
+     * @param u3 终点
+     * @return
+     */
+    static inline int32_t bezier3(uint32_t t,uint32_t u0,uint32_t u1,uint32_t u2,uint32_t u3)
+    {
+        uint32_t t_rem  = 1024 - t;
+        uint32_t t_rem2 = (t_rem * t_rem) >> 10;
+        uint32_t t_rem3 = (t_rem2 * t_rem) >> 10;
+        uint32_t t2     = (t * t) >> 10;
+        uint32_t t3     = (t2 * t) >> 10;
+        uint32_t v1 = (t_rem3 * u0) >> 10;
+        uint32_t v2 = (3 * t_rem2 * t * u1) >> 20;
+        uint32_t v3 = (3 * t_rem * t2 * u2) >> 20;
+        uint32_t v4 = (t3 * u3) >> 10;
+        return v1 + v2 + v3 + v4;
+    }
+
+    /**
+     * @brief 贝塞尔路径的曲线,与 lv_anim_path_xxx 使用相同的控制点
+     * path 是常量时内联后没有分支
+     * @param path PATH_EASE_IN ~ PATH_OVERSHOOT,其他按线性处理
+     * @param t [0,1024]
+     * @return 以1024为结束值
+     */
+    static inline int32_t ease(Path path,uint32_t t)
+    {
+        switch (path)
+        {
+        case PATH_EASE_IN:
+            return bezier3(t,0,1,1,1024);
+        case PATH_EASE_OUT:
+            return bezier3(t,0,1023,1023,1024);
+        case PATH_EASE_IN_OUT:
+            return bezier3(t,0,100,924,1024);
+        case PATH_OVERSHOOT:
+            return bezier3(t,0,1000,1300,1024);
+        default:
+            return (int32_t)t;
+        }
+    }
+
+    /**
+     * @brief 弹跳路径:3次下落,2次弹起,与 lv_anim_path_bounce 相同
+     * 无符号运算,与LVGL的回绕行为保持一致
+     * @param t [0,1024]
+     * @param div 返回这一段幅度的除数
+     * @return 离结束值的距离,以1024为单位,还需要除以 div
+     */
+    static inline int32_t bounceCurve(uint32_t t,int32_t & div)
+    {
+        div = 1;
+        if(t < 408)
+        {
+            t = (t * 2500) >> 10;
+        }
+        else if(t < 614)
+        {
+            t = 1024 - (t - 408) * 5;
+            div = 20;
+        }
+        else if(t < 819)
+        {
+            t = (t - 614) * 5;
+            div = 20;
+        }
+        else if(t < 921)
+        {
+            t = 1024 - (t - 819) * 10;
+            div = 40;
+        }
+        else
+        {
+            t = (t - 921) * 10;
+            div = 40;
+        }
+        if(t > 1024)
+            t = 1024;
+        return bezier3(t,1024,1024,800,0);
+    }
+
+    /**
+     * @brief 内置路径的表
+     * @param path
+     * @return 线性和阶跃不需要查表,返回nullptr
+     */
+    static const LVAnimPathTable * table(Path path);
+
+    /**
+     * @brief 把三次贝塞尔曲线烘焙成表
+     * 起点(0,0),终点(1,1),x 需要在 [0,1] 内
+     * @param table
+     * @param x1 控制点1
+     * @param y1
+     * @param x2 控制点2
+     * @param y2
+     */
+    static void bake(LVAnimPathTable & table,float x1,float y1,float x2,float y2);
+
+    /**
+     * @brief 时长的倒数,用于 progress()
+     * @param time
+     * @return
+     */
+    static inline uint32_t reciprocal(uint32_t time)
+    {
+        return time ? (1u << (LV_ANIM_PATH_PROGRESS_SHIFT + 10)) / time : 0;
+    }
+
+    /**
+     * @brief 用时长的倒数计算进度
+     * 已运行的时间不大于时长时,乘积不超过 2^26
+     * @param act_time
+     * @param recip reciprocal(time)
+     * @return [0,LV_ANIM_PATH_PROGRESS_MAX]
+     */
+    static inline uint32_t progress(uint32_t act_time,uint32_t recip)
+    {
+        return (act_time * recip) >> 10;
+    }
+
+    /**
+     * @brief 按路径表计算动画的当前值
+     * @param table
+     * @param a
+     * @param progress [0,LV_ANIM_PATH_PROGRESS_MAX]
+     * @return
+     */
+    static inline lv_anim_value_t evaluate(const LVAnimPathTable & table,const lv_anim_t * a,uint32_t progress)
+    {
+        int32_t diff = a->end - a->start;
+        return (lv_anim_value_t)(a->start + ((diff * table.at(progress)) >> LV_ANIM_PATH_VALUE_SHIFT));
+    }
+
+    /**
+     * @brief 按路径表计算动画的当前值,进度需要一次除法
+     * @param table
+     * @param a
+     * @return
+     */
+    static lv_anim_value_t evaluate(const LVAnimPathTable & table,const lv_anim_t * a);
+
+    /**
+     * 与 lv_anim_path_xxx 相同的查表版本
+     */
+    static lv_anim_value_t easeIn(const lv_anim_t * a);
+    static lv_anim_value_t easeOut(const lv_anim_t * a);
+    static lv_anim_value_t easeInOut(const lv_anim_t * a);
+    static lv_anim_value_t overShoot(const lv_anim_t * a);
+    static lv_anim_value_t bounce(const lv_anim_t * a);
+
+    /**
+     * @brief 路径的回调函数
+     * @param path
+     * @return
+     */
+    static lv_anim_path_cb_t callBack(Path path);
+
+private:
+    LVAnimPath() = delete;
+    ~LVAnimPath() = delete;
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_ANIMATION*/
+
+#endif // LVANIMPATH_H
@@ -1,5 +1,6 @@
 #include "LVAnimation.h"
 #include <lv_misc/lv_ll.h>
+#include <lv_misc/lv_gc.h>
 
 extern "C"
 {
@@ -63,3 +64,58 @@ bool LVAnimation::isVaild(lv_anim_t *anim)
 {
     return anim && reinterpret_cast<LVAnimation*>(anim->class_ptr.pointer) == static_cast<LVAnimation*>(anim);
 }
+
+uint32_t LVAnimation::nextSerial()
+{
+    static uint32_t s_serial = 0;
+    return ++s_serial;
+}
+
+bool LVAnimation::isRunning(const lv_anim_t *anim, uint32_t serial)
+{
+    lv_anim_t * a = static_cast<lv_anim_t *>(lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)));
+    while (a)
+    {
+        if(a == anim)
+            return isVaild(a) && static_cast<LVAnimation *>(a)->m_serial == serial;
+        a = static_cast<lv_anim_t *>(lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll),a));
+    }
+    return false;
+}
+
+void LVAnimation::setPath(LVAnimPath::Path path)
+{
+    m_pathTable = LVAnimPath::table(path);
+    if(m_pathTable)
+        lv_anim_set_path_cb(this,pathTableAgent);
+    else
+        lv_anim_set_path_cb(this,LVAnimPath::callBack(path));
+}
+
+bool LVAnimation::setPathBezier(float x1, float y1, float x2, float y2)
+{
+    if(m_pathBaked == nullptr)
+        m_pathBaked = new LVAnimPathTable;
+    if(m_pathBaked == nullptr)
+        return false;
+
+    LVAnimPath::bake(*m_pathBaked,x1,y1,x2,y2);
+    m_pathTable = m_pathBaked;
+    lv_anim_set_path_cb(this,pathTableAgent);
+    return true;
+}
+
+LVAnimValue LVAnimation::pathTableAgent(const lv_anim_t *a)
+{
+    LVAnimation * anim = (LVAnimation *)a;
+    if(a->act_time >= (int32_t)a->time)
+        return (LVAnimValue)a->end;
+
+    //时长变化时才重新计算倒数
+    if(anim->m_pathTime != a->time)
+    {
+        anim->m_pathTime = a->time;
+        anim->m_pathRecip = LVAnimPath::reciprocal(a->time);
+    }
+    return LVAnimPath::evaluate(*anim->m_pathTable,a,LVAnimPath::progress(a->act_time,anim->m_pathRecip));
+}
@@ -17,6 +17,7 @@
 #include "LVMemory.h"
 #include "../LVCore/LVCallBack.h"
 #include "../LVMisc/LVLinkList.h"
+#include "LVAnimPath.h"
 
 /*********************
  *      DEFINES
@@ -85,6 +86,14 @@ protected:
     LVAnimPathCallBack       m_path_cb;   /*An array with the steps of animations*/
     LVAnimReadyCallBack      m_ready_cb;  /*Call it when the animation is ready*/
 
+    const LVAnimPathTable *  m_pathTable = nullptr; //!< 查表路径
+    LVAnimPathTable *        m_pathBaked = nullptr; //!< 烘焙的贝塞尔曲线表
+    uint32_t                 m_pathRecip = 0;       //!< 时长的倒数
+    uint32_t                 m_pathTime = 0;        //!< 倒数对应的时长
+    uint32_t                 m_serial;              //!< 创建序号,地址被重用时区分不同的动画
+
+    static uint32_t nextSerial();
+
 public:
 
     /** Can be used to indicate if animations are enabled or disabled in a case*/
@@ -114,6 +123,7 @@ public:
         class_ptr.full = this;
         class_ptr.deleted = false;
         LVMemory::unsetNewAnimAddr();
+        m_serial = nextSerial();
 
         lvTrace("LVAnimation(0x%p) Created.",this);
     }
@@ -126,6 +136,7 @@ public:
             //首先清理掉在动画框架中的副本数据
             lv_anim_del(this->var,NULL);
         }
+        delete m_pathBaked;
 
         lvTrace("LVAnimation(0x%p) Destroyed.",this);
     }
@@ -143,6 +154,22 @@ public:
      */
     static bool isVaild(lv_anim_t * anim);
 
+    /**
+     * @brief 创建序号
+     * 动画结束后内存可能马上被新的动画重用,地址相同时用序号区分
+     * @return
+     */
+    uint32_t serial() const { return m_serial; }
+
+    /**
+     * @brief 动画是否仍在运行
+     * 只在LVGL的动画列表中比较地址和序号,不访问已删除的动画
+     * @param anim
+     * @param serial 等待时记录的 serial()
+     * @return
+     */
+    static bool isRunning(const lv_anim_t * anim, uint32_t serial);
+
     /**
      * Init. the animation module
      */
@@ -209,9 +236,28 @@ public:
     void setPathCallBack(const LVAnimPathCallBack& path_cb)
     {
         m_path_cb = path_cb;
+        m_pathTable = nullptr;
         lv_anim_set_path_cb(this,pathCallBackAgent);
     }
 
+    /**
+     * @brief 使用查表的内置路径
+     * 每帧不调用贝塞尔计算,时长的倒数缓存在动画中,不需要除法
+     * @param path
+     */
+    void setPath(LVAnimPath::Path path);
+
+    /**
+     * @brief 使用三次贝塞尔曲线路径,与CSS的 cubic-bezier(x1,y1,x2,y2) 相同
+     * 设置时烘焙成表,运行时与内置路径一样查表
+     * @param x1 控制点1,x 在 [0,1] 内
+     * @param y1
+     * @param x2 控制点2,x 在 [0,1] 内
+     * @param y2
+     * @return 申请内存失败时返回false
+     */
+    bool setPathBezier(float x1,float y1,float x2,float y2);
+
     /**
      * Set a function call when the animation is ready
      * @param a pointer to an initialized `lv_anim_t` variable
@@ -336,7 +382,7 @@ public:
      */
     LVAnimValue pathEaseIn()
     {
-        return lv_anim_path_ease_in(this);
+        return LVAnimPath::easeIn(this);
     }
 
     /**
@@ -346,7 +392,7 @@ public:
      */
     LVAnimValue pathEaseOut()
     {
-        return lv_anim_path_ease_out(this);
+        return LVAnimPath::easeOut(this);
     }
 
     /**
@@ -356,7 +402,7 @@ public:
      */
     LVAnimValue pathEaseInOut()
     {
-        return lv_anim_path_ease_in_out(this);
+        return LVAnimPath::easeInOut(this);
     }
 
     /**
@@ -366,7 +412,7 @@ public:
      */
     LVAnimValue pathOverShoot()
     {
-        return lv_anim_path_overshoot(this);
+        return LVAnimPath::overShoot(this);
     }
 
     /**
@@ -376,7 +422,7 @@ public:
      */
     LVAnimValue pathBounce()
     {
-        return lv_anim_path_bounce(this);
+        return LVAnimPath::bounce(this);
     }
 
     /**
@@ -414,6 +460,8 @@ public:
         return 0;
     }
 
+    static LVAnimValue pathTableAgent(const lv_anim_t * a);
+
     static void readyCallBackAgent(lv_anim_t * a)
     {
         LVAnimation * anim = static_cast<LVAnimation *>(a);
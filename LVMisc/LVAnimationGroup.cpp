@@ -0,0 +1,401 @@
+#include "LVAnimationGroup.h"
+
+#if LV_USE_ANIMATION
+
+#include <lv_hal/lv_hal_tick.h>
+
+/**
+ * 把一段进度按贝塞尔曲线变换,path 是常量,内联后循环可以向量化
+ */
+static inline void bezierRange(int32_t * value, uint32_t first, uint32_t last, LVAnimPath::Path path)
+{
+    for (uint32_t i = first; i < last; ++i)
+        value[i] = LVAnimPath::ease(path,value[i]);
+}
+
+LVAnimationGroup * LVAnimationGroup::s_first = nullptr;
+
+LVAnimationGroup::LVAnimationGroup(uint32_t period)
+{
+    m_task = new LVTask(taskCallBack,period,LVTask::PRIO_MID);
+    m_task->setUserData(this);
+
+    m_next = s_first;
+    if(s_first)
+        s_first->m_prev = this;
+    s_first = this;
+}
+
+LVAnimationGroup::~LVAnimationGroup()
+{
+    if(m_prev)
+        m_prev->m_next = m_next;
+    else
+        s_first = m_next;
+    if(m_next)
+        m_next->m_prev = m_prev;
+
+    delete m_task;
+}
+
+void LVAnimationGroup::removeAll(void *var)
+{
+    for (LVAnimationGroup * group = s_first; group; group = group->m_next)
+    {
+        //空的组不检查,删除大量对象时不拖慢
+        if(group->m_var.empty() && group->m_pending.empty())
+            continue;
+        group->remove(var);
+    }
+}
+
+void LVAnimationGroup::reserve(uint32_t n)
+{
+    m_var.reserve(n);
+    m_exec.reserve(n);
+    m_start.reserve(n);
+    m_end.reserve(n);
+    m_time.reserve(n);
+    m_act.reserve(n);
+    m_flags.reserve(n);
+    m_last.reserve(n);
+    m_value.reserve(n);
+}
+
+void LVAnimationGroup::add(void *var, lv_anim_exec_xcb_t exec, LVAnimValue start, LVAnimValue end,
+                           uint16_t time, uint16_t delay, Path path, uint8_t flags)
+{
+    if(path >= LVAnimPath::_PATH_NUM)
+        path = LVAnimPath::PATH_LINEAR;
+
+    //执行函数中加入的动画,等本帧结束,避免移动正在处理的列
+    if(m_updating)
+    {
+        removePending(var,exec);
+        m_pending.push_back(PendingEntry{var,exec,start,end,time,delay,path,flags});
+        return;
+    }
+
+    remove(var,exec);
+
+    uint32_t hole = m_var.size();
+    m_var.push_back(nullptr);
+    m_exec.push_back(nullptr);
+    m_start.push_back(0);
+    m_end.push_back(0);
+    m_time.push_back(0);
+    m_act.push_back(0);
+    m_flags.push_back(0);
+    m_last.push_back(0);
+    m_value.push_back(0);
+
+    //新动画放在路径段的末尾,后面的每个路径段把第一个动画移到自己的末尾
+    for (uint8_t q = LVAnimPath::_PATH_NUM - 1; q > path; --q)
+    {
+        if(m_begin[q] != hole)
+            copyEntry(hole,m_begin[q]);
+        hole = m_begin[q];
+        ++m_begin[q];
+    }
+    ++m_begin[LVAnimPath::_PATH_NUM];
+
+    m_var[hole] = var;
+    m_exec[hole] = exec;
+    m_start[hole] = start;
+    m_end[hole] = end;
+    m_time[hole] = time;
+    m_act[hole] = -(int32_t)delay;
+    m_flags[hole] = flags & (FLAG_PLAYBACK | FLAG_REPEAT);
+    m_last[hole] = INT32_MIN;
+
+    if(!m_task->isRunning())
+    {
+        m_lastTick = lv_tick_get();
+        m_task->start();
+    }
+}
+
+bool LVAnimationGroup::remove(void *var, lv_anim_exec_xcb_t exec)
+{
+    bool removed = removePending(var,exec);
+
+    //执行函数中删除的动画只做标记,本帧结束时移除
+    if(m_updating)
+    {
+        for (uint32_t i = 0; i < m_var.size(); ++i)
+        {
+            if(!(m_flags[i] & FLAG_REMOVED) && m_var[i] == var && (exec == nullptr || m_exec[i] == exec))
+            {
+                m_flags[i] |= FLAG_REMOVED;
+                m_exec[i] = nullptr;
+                removed = true;
+            }
+        }
+        return removed;
+    }
+
+    //从后往前,删除只会移动已经检查过的动画
+    for (uint32_t i = m_var.size(); i-- > 0;)
+    {
+        if(m_var[i] == var && (exec == nullptr || m_exec[i] == exec))
+        {
+            removeAt(i);
+            removed = true;
+        }
+    }
+    return removed;
+}
+
+void LVAnimationGroup::clear()
+{
+    m_pending.clear();
+    if(m_updating)
+    {
+        for (uint32_t i = 0; i < m_var.size(); ++i)
+        {
+            m_flags[i] |= FLAG_REMOVED;
+            m_exec[i] = nullptr;
+        }
+        return;
+    }
+
+    m_var.clear();
+    m_exec.clear();
+    m_start.clear();
+    m_end.clear();
+    m_time.clear();
+    m_act.clear();
+    m_flags.clear();
+    m_last.clear();
+    m_value.clear();
+    for (uint8_t q = 0; q <= LVAnimPath::_PATH_NUM; ++q)
+        m_begin[q] = 0;
+    if(m_task->isRunning())
+        m_task->stop();
+}
+
+bool LVAnimationGroup::contains(void *var, lv_anim_exec_xcb_t exec) const
+{
+    for (uint32_t i = 0; i < m_var.size(); ++i)
+    {
+        if(!(m_flags[i] & FLAG_REMOVED) && m_var[i] == var && (exec == nullptr || m_exec[i] == exec))
+            return true;
+    }
+    for (uint32_t i = 0; i < m_pending.size(); ++i)
+    {
+        if(m_pending[i].var == var && (exec == nullptr || m_pending[i].exec == exec))
+            return true;
+    }
+    return false;
+}
+
+void LVAnimationGroup::update(uint32_t elapsed)
+{
+    uint32_t n = m_var.size();
+    if(n == 0)
+        return;
+
+    int32_t * act = m_act.data();
+    const uint16_t * time = m_time.data();
+    const int32_t * start = m_start.data();
+    const int32_t * end = m_end.data();
+    int32_t * value = m_value.data();
+
+    //推进时间,计算进度 [0,1024]
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        int32_t a = act[i] + (int32_t)elapsed;
+        int32_t t = time[i];
+        if(a > t)
+            a = t;
+        act[i] = a;
+        value[i] = a >= t ? 1024 : (a <= 0 ? 0 : (a << 10) / t);
+    }
+
+    //按路径变换进度,与 lv_anim_path_xxx 使用相同的控制点
+    bezierRange(value,m_begin[LVAnimPath::PATH_EASE_IN],m_begin[LVAnimPath::PATH_EASE_IN + 1],LVAnimPath::PATH_EASE_IN);
+    bezierRange(value,m_begin[LVAnimPath::PATH_EASE_OUT],m_begin[LVAnimPath::PATH_EASE_OUT + 1],LVAnimPath::PATH_EASE_OUT);
+    bezierRange(value,m_begin[LVAnimPath::PATH_EASE_IN_OUT],m_begin[LVAnimPath::PATH_EASE_IN_OUT + 1],LVAnimPath::PATH_EASE_IN_OUT);
+    bezierRange(value,m_begin[LVAnimPath::PATH_OVERSHOOT],m_begin[LVAnimPath::PATH_OVERSHOOT + 1],LVAnimPath::PATH_OVERSHOOT);
+
+    //路径段的边界放在局部变量中,循环次数可以预先确定
+    const uint32_t bounce = m_begin[LVAnimPath::PATH_BOUNCE];
+    const uint32_t step = m_begin[LVAnimPath::PATH_STEP];
+    const uint32_t stepEnd = m_begin[LVAnimPath::PATH_STEP + 1];
+
+    //线性和贝塞尔路径连续存放,一个循环计算数值
+    for (uint32_t i = 0; i < bounce; ++i)
+        value[i] = start[i] + (((end[i] - start[i]) * value[i]) >> 10);
+
+    //弹跳:3次下落,2次弹起,与 lv_anim_path_bounce 相同
+    for (uint32_t i = bounce; i < step; ++i)
+    {
+        int32_t div;
+        int32_t fall = LVAnimPath::bounceCurve(value[i],div);
+        int32_t diff = (end[i] - start[i]) / div;
+        value[i] = end[i] - ((fall * diff) >> 10);
+    }
+
+    for (uint32_t i = step; i < stepEnd; ++i)
+        value[i] = value[i] >= 1024 ? end[i] : start[i];
+
+    //统一执行,延时中和值未变化的不执行
+    int32_t * last = m_last.data();
+    void ** var = m_var.data();
+    lv_anim_exec_xcb_t * exec = m_exec.data();
+    m_updating = true;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if(act[i] >= 0 && value[i] != last[i])
+        {
+            last[i] = value[i];
+            if(exec[i])
+                exec[i](var[i],(LVAnimValue)value[i]);
+        }
+    }
+    m_updating = false;
+
+    //结束的动画,从后往前删除
+    for (uint32_t i = n; i-- > 0;)
+    {
+        if(m_flags[i] & FLAG_REMOVED)
+        {
+            removeAt(i);
+            continue;
+        }
+        if(m_act[i] >= m_time[i] && finish(i))
+        {
+            if(m_readyCallBack)
+            {
+                m_readyVar.push_back(m_var[i]);
+                m_readyExec.push_back(m_exec[i]);
+            }
+            removeAt(i);
+        }
+    }
+
+    //执行函数中加入的动画
+    while (!m_pending.empty())
+    {
+        PendingEntry e = m_pending[0];
+        m_pending.erase(m_pending.begin());
+        add(e.var,e.exec,e.start,e.end,e.time,e.delay,e.path,e.flags);
+    }
+
+    if(m_var.empty())
+        m_task->stop();
+
+    //回调中可以加入新的动画
+    if(!m_readyVar.empty())
+    {
+        for (uint32_t i = 0; i < m_readyVar.size(); ++i)
+            m_readyCallBack(this,m_readyVar[i],m_readyExec[i]);
+        m_readyVar.clear();
+        m_readyExec.clear();
+    }
+}
+
+void LVAnimationGroup::copyEntry(uint32_t dst, uint32_t src)
+{
+    m_var[dst] = m_var[src];
+    m_exec[dst] = m_exec[src];
+    m_start[dst] = m_start[src];
+    m_end[dst] = m_end[src];
+    m_time[dst] = m_time[src];
+    m_act[dst] = m_act[src];
+    m_flags[dst] = m_flags[src];
+    m_last[dst] = m_last[src];
+}
+
+void LVAnimationGroup::removeAt(uint32_t i)
+{
+    uint8_t path = pathOf(i);
+
+    //路径段的最后一个填补空位,后面的每个路径段把最后一个移到前面的空位
+    uint32_t hole = i;
+    for (uint8_t q = path; q < LVAnimPath::_PATH_NUM; ++q)
+    {
+        if(m_begin[q] == m_begin[q + 1])
+            continue;
+        uint32_t last = m_begin[q + 1] - 1;
+        if(last != hole)
+            copyEntry(hole,last);
+        hole = last;
+    }
+    for (uint8_t q = path + 1; q <= LVAnimPath::_PATH_NUM; ++q)
+        --m_begin[q];
+
+    m_var.pop_back();
+    m_exec.pop_back();
+    m_start.pop_back();
+    m_end.pop_back();
+    m_time.pop_back();
+    m_act.pop_back();
+    m_flags.pop_back();
+    m_last.pop_back();
+    m_value.pop_back();
+}
+
+bool LVAnimationGroup::removePending(void *var, lv_anim_exec_xcb_t exec)
+{
+    bool removed = false;
+    for (uint32_t i = m_pending.size(); i-- > 0;)
+    {
+        if(m_pending[i].var == var && (exec == nullptr || m_pending[i].exec == exec))
+        {
+            m_pending.erase(m_pending.begin() + i);
+            removed = true;
+        }
+    }
+    return removed;
+}
+
+uint8_t LVAnimationGroup::pathOf(uint32_t i) const
+{
+    uint8_t q = 0;
+    while (q + 1 < LVAnimPath::_PATH_NUM && i >= m_begin[q + 1])
+        ++q;
+    return q;
+}
+
+bool LVAnimationGroup::finish(uint32_t i)
+{
+    uint8_t flags = m_flags[i];
+
+    //正向结束后反向运行
+    if((flags & FLAG_PLAYBACK) && !(flags & FLAG_BACKWARD))
+    {
+        int32_t tmp = m_start[i];
+        m_start[i] = m_end[i];
+        m_end[i] = tmp;
+        m_flags[i] = flags | FLAG_BACKWARD;
+        m_act[i] = 0;
+        return false;
+    }
+
+    if(flags & FLAG_REPEAT)
+    {
+        if(flags & FLAG_BACKWARD)
+        {
+            int32_t tmp = m_start[i];
+            m_start[i] = m_end[i];
+            m_end[i] = tmp;
+            m_flags[i] = flags & ~FLAG_BACKWARD;
+        }
+        m_act[i] = 0;
+        return false;
+    }
+
+    return true;
+}
+
+void LVAnimationGroup::taskCallBack(LVTask *task)
+{
+    LVAnimationGroup * group = static_cast<LVAnimationGroup *>(task->getUserData());
+    uint32_t now = lv_tick_get();
+    uint32_t elapsed = now - group->m_lastTick;
+    group->m_lastTick = now;
+    group->update(elapsed);
+}
+
+#endif // LV_USE_ANIMATION
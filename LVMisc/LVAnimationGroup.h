@@ -0,0 +1,237 @@
+/**
+ * @file LVAnimationGroup.h
+ *
+ */
+
+#ifndef LVANIMATIONGROUP_H
+#define LVANIMATIONGROUP_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lv_misc/lv_anim.h>
+
+#if LV_USE_ANIMATION
+
+#include "LVMemory.h"
+#include "lvvector.h"
+#include "LVAnimation.h"
+#include "LVTask.h"
+#include "../LVCore/LVCallBack.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 动画组默认的刷新周期(毫秒)
+ */
+#ifndef LV_ANIM_GROUP_PERIOD
+#define LV_ANIM_GROUP_PERIOD LV_DISP_DEF_REFR_PERIOD
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+class LVAnimationGroup;
+
+/**
+ * 组中的一个动画结束时的回调,参数为动画的变量和执行函数
+ */
+using LVAnimGroupReadyCallBack = LVCallBack<void(LVAnimationGroup *,void *,lv_anim_exec_xcb_t),void>;
+
+/**
+ * @brief 批量动画
+ * 大量同时运行的动画(列表滚动效果,仪表)放在一个组中,
+ * 起止值,时长,进度按列连续存放(SoA),按路径分段排列,
+ * 每帧对每种内置路径运行一个紧凑的循环,再统一调用执行函数.
+ * 整个组只有一个 LVTask,没有 lv_anim_t 和逐个动画的回调对象.
+ *
+ * 例子:
+ * LVAnimationGroup group;
+ * for(...)
+ *     group.add(item,(lv_anim_exec_xcb_t)lv_obj_set_y,y0,y1,300,i*20,LVAnimPath::PATH_EASE_OUT);
+ *
+ * 与 lv_anim_create 一样,同一个变量和执行函数的旧动画会被替换.
+ * 值没有变化时不调用执行函数.
+ * 执行函数中可以加入和删除动画,在本帧结束时生效.
+ * 与 lv_anim 一样,对象删除时(lv_obj_del)所有组中这个对象的动画自动删除;
+ * 其他类型的变量释放前需要调用 remove(var).
+ *
+ * NOTE: 只支持内置路径;往返和重复没有等待时间
+ */
+class LVAnimationGroup
+{
+    LV_MEMORY
+
+public:
+    /**
+     * @brief 内置的动画路径,与 LVAnimation::setPath() 相同
+     */
+    using Path = LVAnimPath::Path;
+
+    enum Flag : uint8_t
+    {
+        FLAG_PLAYBACK = 0x01, //!< 结束后反向运行一次
+        FLAG_REPEAT   = 0x02, //!< 结束后重新开始
+        FLAG_BACKWARD = 0x04, //!< 正在反向运行(内部使用)
+        FLAG_REMOVED  = 0x08, //!< 刷新中被删除,本帧结束时移除(内部使用)
+    };
+
+protected:
+    LVVector<void *> m_var;                  //!< 动画的变量
+    LVVector<lv_anim_exec_xcb_t> m_exec;     //!< 执行函数
+    LVVector<int32_t> m_start;               //!< 起始值
+    LVVector<int32_t> m_end;                 //!< 结束值
+    LVVector<uint16_t> m_time;               //!< 时长
+    LVVector<int32_t> m_act;                 //!< 已运行的时间,负数表示延时
+    LVVector<uint8_t> m_flags;               //!< Flag
+    LVVector<int32_t> m_last;                //!< 上一次执行的值
+    LVVector<int32_t> m_value;               //!< 本帧的进度和值(计算用)
+    uint32_t m_begin[LVAnimPath::_PATH_NUM + 1] = {0}; //!< 每种路径在列中的起始位置
+
+    LVTask * m_task;                         //!< 刷新任务
+    uint32_t m_lastTick = 0;                 //!< 上一次刷新的时钟
+    LVAnimGroupReadyCallBack m_readyCallBack;
+    LVVector<void *> m_readyVar;             //!< 本帧结束的动画(延后回调)
+    LVVector<lv_anim_exec_xcb_t> m_readyExec;
+
+    /**
+     * @brief 刷新中加入的动画,本帧结束时加入
+     */
+    struct PendingEntry
+    {
+        void * var;
+        lv_anim_exec_xcb_t exec;
+        LVAnimValue start;
+        LVAnimValue end;
+        uint16_t time;
+        uint16_t delay;
+        Path path;
+        uint8_t flags;
+    };
+    LVVector<PendingEntry> m_pending;
+    bool m_updating = false;                 //!< 正在调用执行函数
+    LVAnimationGroup * m_prev = nullptr;     //!< 所有动画组的链表
+    LVAnimationGroup * m_next = nullptr;
+
+    static LVAnimationGroup * s_first;
+
+public:
+    /**
+     * @brief 动画组
+     * @param period 刷新周期
+     */
+    LVAnimationGroup(uint32_t period = LV_ANIM_GROUP_PERIOD);
+    ~LVAnimationGroup();
+
+    /**
+     * @brief 预留动画数量,避免运行中扩充
+     * @param n
+     */
+    void reserve(uint32_t n);
+
+    /**
+     * @brief 加入一个动画,替换相同变量和执行函数的动画
+     * @param var 动画的变量
+     * @param exec 执行函数,比如 (lv_anim_exec_xcb_t)lv_obj_set_x
+     * @param start 起始值
+     * @param end 结束值
+     * @param time 时长(毫秒)
+     * @param delay 开始前的延时(毫秒)
+     * @param path 路径
+     * @param flags FLAG_PLAYBACK | FLAG_REPEAT
+     */
+    void add(void * var,lv_anim_exec_xcb_t exec,LVAnimValue start,LVAnimValue end,
+             uint16_t time,uint16_t delay = 0,Path path = LVAnimPath::PATH_LINEAR,uint8_t flags = 0);
+
+    /**
+     * @brief 删除变量的动画
+     * @param var
+     * @param exec nullptr表示删除变量的所有动画
+     * @return 是否删除了动画
+     */
+    bool remove(void * var,lv_anim_exec_xcb_t exec = nullptr);
+
+    /**
+     * @brief 删除所有动画
+     */
+    void clear();
+
+    /**
+     * @brief 正在运行的动画数量
+     * @return
+     */
+    uint32_t count() const { return m_var.size(); }
+
+    /**
+     * @brief 变量是否有动画
+     * @param var
+     * @param exec nullptr表示任意执行函数
+     * @return
+     */
+    bool contains(void * var,lv_anim_exec_xcb_t exec = nullptr) const;
+
+    /**
+     * @brief 设置动画结束时的回调
+     * @param ready_cb
+     */
+    void setReadyCallBack(const LVAnimGroupReadyCallBack & ready_cb) { m_readyCallBack = ready_cb; }
+
+    /**
+     * @brief 推进所有动画并执行
+     * 由刷新任务调用,也可以手动调用
+     * @param elapsed 经过的毫秒数
+     */
+    void update(uint32_t elapsed);
+
+    /**
+     * @brief 从所有动画组中删除变量的动画
+     * 对象删除时由 lv_obj_del_custom 调用
+     * @param var
+     */
+    static void removeAll(void * var);
+
+protected:
+    /**
+     * @brief 把 src 位置的动画拷贝到 dst
+     */
+    void copyEntry(uint32_t dst,uint32_t src);
+
+    /**
+     * @brief 删除位置 i 的动画,后面的路径段依次前移一个
+     */
+    void removeAt(uint32_t i);
+
+    /**
+     * @brief 删除等待加入的动画
+     * @return 是否删除了动画
+     */
+    bool removePending(void * var,lv_anim_exec_xcb_t exec);
+
+    /**
+     * @brief 位置 i 所在的路径
+     */
+    uint8_t pathOf(uint32_t i) const;
+
+    /**
+     * @brief 动画运行到结尾,处理往返和重复
+     * @return 动画是否结束
+     */
+    bool finish(uint32_t i);
+
+    static void taskCallBack(LVTask * task);
+
+private:
+    LVAnimationGroup(const LVAnimationGroup&) = delete;
+    LVAnimationGroup& operator = (const LVAnimationGroup&) = delete;
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_ANIMATION*/
+
+#endif // LVANIMATIONGROUP_H
@@ -0,0 +1,196 @@
+#include "LVAsyncTask.h"
+
+#if LV_USE_ASYNC_TASK
+
+#include "LVTask.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#ifdef ESP_PLATFORM
+#include <esp_pthread.h>
+#endif
+
+std::atomic<LVAsyncJob *> LVAsyncTask::s_doneHead(nullptr);
+LVAsyncJob * LVAsyncTask::s_pendingList = nullptr;
+uint32_t LVAsyncTask::s_pendingCount = 0;
+uint32_t LVAsyncTask::s_nextId = 0;
+
+namespace
+{
+/**
+ * @brief 后台线程池
+ * 第一次使用时创建,不随静态对象析构,避免退出时线程还在等待已析构的锁
+ */
+struct LVAsyncPool
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+    LVAsyncJob * head = nullptr; //!< 工作队列
+    LVAsyncJob * tail = nullptr;
+    bool stopping = false;
+    std::thread * threads[LV_ASYNC_TASK_THREADS] = {nullptr};
+};
+
+LVAsyncPool * s_pool = nullptr;
+}
+
+uint32_t LVAsyncTask::submit(LVAsyncJob *job)
+{
+    if(++s_nextId == 0)
+        ++s_nextId;
+    job->m_id = s_nextId;
+
+    //加入进行中列表
+    job->m_prev = nullptr;
+    job->m_next = s_pendingList;
+    if(s_pendingList)
+        s_pendingList->m_prev = job;
+    s_pendingList = job;
+    ++s_pendingCount;
+
+    if(s_pool == nullptr)
+    {
+        s_pool = new LVAsyncPool;
+#ifdef ESP_PLATFORM
+        esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+        cfg.stack_size = LV_ASYNC_TASK_STACK_SIZE;
+        cfg.thread_name = "lv_async";
+        esp_pthread_set_cfg(&cfg);
+#endif
+        for (uint8_t i = 0; i < LV_ASYNC_TASK_THREADS; ++i)
+            s_pool->threads[i] = new std::thread(worker);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_pool->mutex);
+        job->m_link = nullptr;
+        if(s_pool->tail)
+            s_pool->tail->m_link = job;
+        else
+            s_pool->head = job;
+        s_pool->tail = job;
+    }
+    s_pool->cond.notify_one();
+    return job->m_id;
+}
+
+void LVAsyncTask::worker()
+{
+    LVAsyncPool * pool = s_pool;
+    while (true)
+    {
+        LVAsyncJob * job;
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->cond.wait(lock,[pool]{ return pool->head || pool->stopping; });
+            if(pool->stopping)
+                return;
+            job = pool->head;
+            pool->head = job->m_link;
+            if(pool->head == nullptr)
+                pool->tail = nullptr;
+        }
+
+        //取消的任务不再运行,但仍交回GUI线程删除
+        if(!job->m_cancelled.load(std::memory_order_relaxed))
+            job->work();
+        pushDone(job);
+        LVTask::wake();
+    }
+}
+
+void LVAsyncTask::pushDone(LVAsyncJob *job)
+{
+    LVAsyncJob * head = s_doneHead.load(std::memory_order_relaxed);
+    do
+    {
+        job->m_link = head;
+    }
+    while (!s_doneHead.compare_exchange_weak(head,job,std::memory_order_release,std::memory_order_relaxed));
+}
+
+bool LVAsyncTask::cancel(uint32_t id)
+{
+    for (LVAsyncJob * job = s_pendingList; job; job = job->m_next)
+    {
+        if(job->m_id == id)
+        {
+            job->m_cancelled.store(true,std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t LVAsyncTask::dispatch()
+{
+    LVAsyncJob * list = s_doneHead.exchange(nullptr,std::memory_order_acquire);
+    if(list == nullptr)
+        return 0;
+
+    //完成栈是后进先出,翻转后按完成顺序处理
+    LVAsyncJob * ordered = nullptr;
+    while (list)
+    {
+        LVAsyncJob * next = list->m_link;
+        list->m_link = ordered;
+        ordered = list;
+        list = next;
+    }
+
+    uint32_t count = 0;
+    while (ordered)
+    {
+        LVAsyncJob * job = ordered;
+        ordered = job->m_link;
+
+        //移出进行中列表,结果回调中可以提交新的任务
+        if(job->m_prev)
+            job->m_prev->m_next = job->m_next;
+        else
+            s_pendingList = job->m_next;
+        if(job->m_next)
+            job->m_next->m_prev = job->m_prev;
+        --s_pendingCount;
+
+        if(!job->isDropped())
+        {
+            job->finish();
+            ++count;
+        }
+        delete job;
+    }
+    return count;
+}
+
+void LVAsyncTask::shutdown()
+{
+    if(s_pool == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(s_pool->mutex);
+        s_pool->stopping = true;
+    }
+    s_pool->cond.notify_all();
+    for (uint8_t i = 0; i < LV_ASYNC_TASK_THREADS; ++i)
+    {
+        s_pool->threads[i]->join();
+        delete s_pool->threads[i];
+    }
+
+    //线程都已退出,丢弃未开始的工作,已完成的结果照常处理
+    for (LVAsyncJob * job = s_pool->head; job; job = job->m_link)
+        job->m_cancelled.store(true,std::memory_order_relaxed);
+    for (LVAsyncJob * job = s_pool->head; job; )
+    {
+        LVAsyncJob * next = job->m_link;
+        pushDone(job);
+        job = next;
+    }
+    delete s_pool;
+    s_pool = nullptr;
+    dispatch();
+}
+
+#endif // LV_USE_ASYNC_TASK
@@ -0,0 +1,243 @@
+/**
+ * @file LVAsyncTask.h
+ *
+ */
+
+#ifndef LVASYNCTASK_H
+#define LVASYNCTASK_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+#include <atomic>
+#include <utility>
+#include <type_traits>
+#include "LVMemory.h"
+#include "LVMemoryArena.h"
+#include "../LVCore/LVPointer.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 启用后台线程任务(LVAsyncTask),
+ * 为0时不创建后台线程,lv_task_handler() 也不检查结果队列
+ */
+#ifndef LV_USE_ASYNC_TASK
+#define LV_USE_ASYNC_TASK 0
+#endif
+
+/**
+ * 后台线程数量
+ */
+#ifndef LV_ASYNC_TASK_THREADS
+#define LV_ASYNC_TASK_THREADS 2
+#endif
+
+/**
+ * 后台线程的栈大小(ESP-IDF)
+ */
+#ifndef LV_ASYNC_TASK_STACK_SIZE
+#define LV_ASYNC_TASK_STACK_SIZE 4096
+#endif
+
+#if LV_USE_ASYNC_TASK
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @brief 一次后台运行
+ * 在GUI线程中创建和删除,work() 在后台线程中运行,finish() 回到GUI线程运行.
+ */
+class LVAsyncJob
+{
+    LV_MEMORY
+
+    friend class LVAsyncTask;
+protected:
+    LVAsyncJob * m_link = nullptr;       //!< 工作队列或完成队列中的下一个
+    LVAsyncJob * m_prev = nullptr;       //!< 进行中列表的上一个(GUI线程)
+    LVAsyncJob * m_next = nullptr;       //!< 进行中列表的下一个(GUI线程)
+    uint32_t m_id = 0;                   //!< 取消用的编号
+    std::atomic<bool> m_cancelled;       //!< 已取消,后台线程不再运行
+#if LV_USE_POINTER
+    LVPointer<LVObject> m_target;        //!< 接收结果的对象,删除后丢弃结果
+    bool m_hasTarget = false;
+#endif
+
+public:
+    LVAsyncJob(LVObject * target)
+        : m_cancelled(false)
+    {
+#if LV_USE_POINTER
+        if(target)
+        {
+            m_target.reset(target);
+            m_hasTarget = true;
+        }
+#else
+        (void)target;
+#endif
+    }
+    virtual ~LVAsyncJob() {}
+
+    /**
+     * @brief 结果是否还需要交给GUI线程
+     * @return
+     */
+    bool isDropped() const
+    {
+#if LV_USE_POINTER
+        if(m_hasTarget && m_target.isNull())
+            return true;
+#endif
+        return m_cancelled.load(std::memory_order_relaxed);
+    }
+
+protected:
+    /**
+     * @brief 后台线程中运行
+     */
+    virtual void work() = 0;
+
+    /**
+     * @brief GUI线程中处理结果
+     */
+    virtual void finish() = 0;
+
+private:
+    LVAsyncJob(const LVAsyncJob&) = delete;
+    LVAsyncJob& operator = (const LVAsyncJob&) = delete;
+};
+
+/**
+ * @brief 保存 work 的结果并交给 done
+ */
+template<class Work,class Done,class Result = decltype(std::declval<Work&>()())>
+class LVAsyncCall : public LVAsyncJob
+{
+    Work m_work;
+    Done m_done;
+    Result m_result;
+public:
+    template<class W,class D>
+    LVAsyncCall(W && work,D && done,LVObject * target)
+        : LVAsyncJob(target)
+        , m_work(std::forward<W>(work))
+        , m_done(std::forward<D>(done))
+        , m_result()
+    {}
+protected:
+    void work() override { m_result = m_work(); }
+    void finish() override { m_done(std::move(m_result)); }
+};
+
+template<class Work,class Done>
+class LVAsyncCall<Work,Done,void> : public LVAsyncJob
+{
+    Work m_work;
+    Done m_done;
+public:
+    template<class W,class D>
+    LVAsyncCall(W && work,D && done,LVObject * target)
+        : LVAsyncJob(target)
+        , m_work(std::forward<W>(work))
+        , m_done(std::forward<D>(done))
+    {}
+protected:
+    void work() override { m_work(); }
+    void finish() override { m_done(); }
+};
+
+/**
+ * @brief 后台线程任务
+ * 把阻塞的工作(读文件,解析,解码图片)放到后台线程池中运行,
+ * 结果通过无锁队列交回GUI线程,由 LVTask::handler() 调用 dispatch() 处理.
+ *
+ * 例子:
+ * LVAsyncTask::run([]{ return loadConfig(); },
+ *                  [label](Config c){ label->setText(c.name); },
+ *                  label);
+ * label 被删除后结果被丢弃.
+ *
+ * NOTE: work 中不能调用任何LVGL或LVMemory的函数,所有接口都只能在GUI线程中调用.
+ * 后台线程完成时调用 LVTask::wake(),唤醒回调需要是线程安全的,并在第一次 run() 之前设置
+ */
+class LVAsyncTask
+{
+    LVAsyncTask() = delete;
+    ~LVAsyncTask() = delete;
+public:
+    /**
+     * @brief 在后台线程中运行 work,完成后在GUI线程中调用 done(result)
+     * @param work 无参数的可调用对象,返回结果(可以是void)
+     * @param done 接收结果的可调用对象
+     * @param target 接收结果的对象,删除后不再调用 done
+     * @return 用于 cancel() 的编号
+     */
+    template<class Work,class Done>
+    static uint32_t run(Work && work,Done && done,LVObject * target = nullptr)
+    {
+        typedef LVAsyncCall<typename std::decay<Work>::type,typename std::decay<Done>::type> Call;
+        //任务的生命周期与屏幕无关
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        LVAsyncJob * job = new Call(std::forward<Work>(work),std::forward<Done>(done),target);
+        LVMemoryArena::resume(arena);
+        return submit(job);
+    }
+
+    /**
+     * @brief 取消还没有交回结果的任务
+     * 正在后台运行的工作不会被打断,只是丢弃结果
+     * @param id run() 的返回值
+     * @return 是否找到
+     */
+    static bool cancel(uint32_t id);
+
+    /**
+     * @brief 处理后台线程完成的结果
+     * @return 处理的数量
+     */
+    static uint32_t dispatch();
+
+    /**
+     * @brief 进行中的任务数量
+     * @return
+     */
+    static uint32_t pendingCount() { return s_pendingCount; }
+
+    /**
+     * @brief 是否有等待 dispatch() 的结果
+     * @return
+     */
+    static bool hasResult() { return s_doneHead.load(std::memory_order_relaxed) != nullptr; }
+
+    /**
+     * @brief 停止后台线程,未开始的工作被丢弃
+     * 程序退出前调用,之后再次 run() 会重新创建线程
+     */
+    static void shutdown();
+
+protected:
+    static uint32_t submit(LVAsyncJob * job);
+    static void worker();
+    static void pushDone(LVAsyncJob * job);
+
+    static std::atomic<LVAsyncJob *> s_doneHead; //!< 完成队列(多生产者单消费者的无锁栈)
+    static LVAsyncJob * s_pendingList;          //!< 进行中的任务(GUI线程)
+    static uint32_t s_pendingCount;
+    static uint32_t s_nextId;
+};
+
+#endif // LV_USE_ASYNC_TASK
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif // LVASYNCTASK_H
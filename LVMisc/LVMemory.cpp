@@ -1,5 +1,6 @@
 #include "LVMemory.h"
 #include "LVLog.h"
+#include <string.h>
 
 extern "C"
 {
@@ -40,6 +41,37 @@ extern "C"
     }
 }
 
+LVMemoryClass * LVMemoryClass::s_first = nullptr;
+
+LVMemoryClass::LVMemoryClass(const char *signature)
+{
+    //从 "static LVMemoryClass& XXX::memoryClass()" 中截取 XXX
+    const char * end = strstr(signature,"::memoryClass");
+    if(end == nullptr)
+    {
+        m_name = signature;
+        m_nameLength = strlen(signature);
+    }
+    else
+    {
+        const char * begin = end;
+        int depth = 0;
+        while (begin > signature)
+        {
+            char c = begin[-1];
+            if(c == '>') ++depth;
+            else if(c == '<') --depth;
+            else if((c == ' ' || c == '&' || c == '*') && depth == 0) break;
+            --begin;
+        }
+        m_name = begin;
+        m_nameLength = end - begin;
+    }
+
+    m_next = s_first;
+    s_first = this;
+}
+
 void LVMemoryMonitor::updateMonitor()
 {
     LVMemory::monitor(this);
@@ -14,11 +14,21 @@
 #include <new>
 #include <lv_misc/lv_mem.h>
 #include "../LVMisc/LVLog.h"
+#include "LVMemoryArena.h"
+#include "LVMemoryTrace.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/**
+ * 是否编译内存分配跟踪(调试用),启用后 LV_MEMORY 类的分配会记录所属的类
+ * 运行时还需要 LVMemoryTrace::setEnabled(true)
+ */
+#ifndef LV_USE_MEMORY_TRACE
+#define LV_USE_MEMORY_TRACE 0
+#endif
+
 //BUG:造成内存管理混乱破裂
 
 //class LVMemoryHeader //: public lv_mem_header_t
@@ -84,28 +94,42 @@
 //自定义类的new和delete函数
 //类中第一行使用下面的宏即可
 
+#if LV_USE_MEMORY_TRACE
+//记录分配所属的类
+#define LV_MEMORY_CLASS \
+static LVMemoryClass & memoryClass() \
+{ \
+    static LVMemoryClass cls(__PRETTY_FUNCTION__); \
+    return cls; \
+}
+#define LV_MEMORY_OWNER (&memoryClass())
+#else
+#define LV_MEMORY_CLASS
+#define LV_MEMORY_OWNER nullptr
+#endif
+
 #define LV_MEMORY_NEW \
 static void* operator new(size_t sz) \
 { \
-    return lv_mem_alloc(sz); \
+    return LVMemory::allocate(sz,LV_MEMORY_OWNER); \
 }
 
 #define LV_MEMORY_DELETE \
 static void operator delete(void* p) \
 { \
-    lv_mem_free(p); \
+    LVMemory::free(p); \
 }
 
 #define LV_MEMORY_NEW_ARRAY \
 static void *operator new[](size_t sz) \
 { \
-    return lv_mem_alloc(sz); \
+    return LVMemory::allocate(sz); \
 }
 
 #define LV_MEMORY_DELETE_ARRAY \
 static void operator delete[](void *p) \
 { \
-    lv_mem_free(p); \
+    LVMemory::free(p); \
 }
 
 //placement new
@@ -120,6 +144,7 @@ static void * operator new(size_t /*size*/,void * addr) \
  */
 #define LV_MEMORY \
     public: \
+    LV_MEMORY_CLASS \
     LV_MEMORY_NEW \
     LV_MEMORY_DELETE \
     LV_MEMORY_NEW_ARRAY \
@@ -133,27 +158,65 @@ static void * operator new(size_t /*size*/,void * addr) \
 
 class LVMemory;
 
-class LVMemoryMonitor : public lv_mem_monitor_t
+/**
+ * @brief 类的内存统计
+ * 每个类一份,第一次分配时注册到全局链表中,
+ * 由分级分配器(LV_MEMORY_SLAB)或内存跟踪(LV_USE_MEMORY_TRACE)更新
+ */
+class LVMemoryClass
 {
-    LV_MEMORY
+    friend class LVMemorySlab;
+    friend class LVMemoryTrace;
+protected:
+    const char * m_name;            //!< 类名(不以'\0'结尾)
+    uint16_t m_nameLength;          //!< 类名长度
+    uint32_t m_usedCount = 0;       //!< 存活的对象数量
+    uint32_t m_peakCount = 0;       //!< 存活对象数量峰值
+    uint32_t m_usedSize = 0;        //!< 存活对象占用的字节数
+    uint32_t m_allocCount = 0;      //!< 累计分配次数
+    LVMemoryClass * m_next = nullptr; //!< 下一个注册的类
+
+    static LVMemoryClass * s_first; //!< 注册过的类链表
+
 public:
-    LVMemoryMonitor()
-    {
-        updateMonitor();
-    }
+    /**
+     * @brief 注册一个类
+     * @param signature 类中函数的 __PRETTY_FUNCTION__,从中截取类名
+     */
+    LVMemoryClass(const char * signature);
+
+    const char * name() const { return m_name; }
+    uint16_t nameLength() const { return m_nameLength; }
+    uint32_t usedCount() const { return m_usedCount; }
+    uint32_t peakCount() const { return m_peakCount; }
+    uint32_t usedSize() const { return m_usedSize; }
+    uint32_t allocCount() const { return m_allocCount; }
+    LVMemoryClass * next() const { return m_next; }
 
     /**
-     * @brief update memory monitor information
+     * @brief 注册过的类链表
+     * @return
      */
-    void updateMonitor();
+    static LVMemoryClass * first() { return s_first; }
 
-    uint32_t totalSize(){ return total_size; }
-    uint32_t freeCount(){ return free_cnt; }
-    uint32_t freeSize(){ return free_size; }
-    uint32_t freeBiggestSize(){ return free_biggest_size; }
-    uint32_t usedCount(){ return free_cnt; }
-    uint8_t usedPercent(){ return used_cnt; }
-    uint8_t fragmentPercent(){ return frag_pct; }
+protected:
+    void onAllocate(uint32_t size)
+    {
+        m_usedSize += size;
+        ++m_allocCount;
+        if(++m_usedCount > m_peakCount)
+            m_peakCount = m_usedCount;
+    }
+
+    void onFree(uint32_t size)
+    {
+        m_usedSize -= size;
+        --m_usedCount;
+    }
+
+private:
+    LVMemoryClass(const LVMemoryClass&) = delete;
+    LVMemoryClass& operator = (const LVMemoryClass&) = delete;
 };
 
 class LVMemory
@@ -178,9 +241,33 @@ public:
      * @param size size of the memory to allocate in bytes
      * @return pointer to the allocated memory
      */
-    static void * allocate(uint32_t size)
+    static void * allocate(uint32_t size,LVMemoryClass * owner = nullptr)
+    {
+        void * data = allocateUntraced(size);
+#if LV_USE_MEMORY_TRACE
+        if(data && LVMemoryTrace::isEnabled())
+            LVMemoryTrace::onAllocate(data,size,owner);
+#else
+        (void)owner;
+#endif
+        return data;
+    }
+
+    /**
+     * @brief 分配内存,不记录到 LVMemoryTrace
+     * 用于自己统计类的分配(如 LVMemorySlab),避免重复计数
+     * @param size
+     * @return
+     */
+    static void * allocateUntraced(uint32_t size)
     {
-        return lv_mem_alloc(size);
+        void * data = nullptr;
+        //在屏幕等内存区中分配
+        if(LVMemoryArena * arena = LVMemoryArena::active())
+            data = arena->allocate(size);
+        if(data == nullptr)
+            data = lv_mem_alloc(size);
+        return data;
     }
 
     /**
@@ -189,7 +276,14 @@ public:
      */
     static void free(const void * data)
     {
-        lv_mem_free(data);
+#if LV_USE_MEMORY_TRACE
+        if(data && LVMemoryTrace::isEnabled())
+            LVMemoryTrace::onFree(data);
+#endif
+        if(LVMemoryArena * arena = LVMemoryArena::find(data))
+            arena->free(data);
+        else
+            lv_mem_free(data);
     }
 
     /**
@@ -201,7 +295,19 @@ public:
      */
     static void * reallocate(void * data_p, uint32_t new_size)
     {
-        return lv_mem_realloc(data_p, new_size);
+        if(data_p == nullptr)
+            return allocate(new_size);
+        void * data = nullptr;
+        //保持在原来所属的内存区中
+        if(LVMemoryArena * arena = LVMemoryArena::find(data_p))
+            data = arena->reallocate(data_p,new_size);
+        else
+            data = lv_mem_realloc(data_p, new_size);
+#if LV_USE_MEMORY_TRACE
+        if(data && LVMemoryTrace::isEnabled())
+            LVMemoryTrace::onReallocate(data_p,data,new_size);
+#endif
+        return data;
     }
 
     /**
@@ -229,6 +335,8 @@ public:
      */
     static uint32_t getSize(const void * data)
     {
+        if(LVMemoryArena::find(data))
+            return LVMemoryArena::getSize(data);
         return lv_mem_get_size(data);
     }
 
@@ -288,6 +396,29 @@ public:
     static void unsetNewGroupAddr();
 };
 
+class LVMemoryMonitor : public lv_mem_monitor_t
+{
+    LV_MEMORY
+public:
+    LVMemoryMonitor()
+    {
+        updateMonitor();
+    }
+
+    /**
+     * @brief update memory monitor information
+     */
+    void updateMonitor();
+
+    uint32_t totalSize(){ return total_size; }
+    uint32_t freeCount(){ return free_cnt; }
+    uint32_t freeSize(){ return free_size; }
+    uint32_t freeBiggestSize(){ return free_biggest_size; }
+    uint32_t usedCount(){ return free_cnt; }
+    uint8_t usedPercent(){ return used_cnt; }
+    uint8_t fragmentPercent(){ return frag_pct; }
+};
+
 /**********************
  *      MACROS
  **********************/
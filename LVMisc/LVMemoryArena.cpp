@@ -0,0 +1,254 @@
+#include "LVMemoryArena.h"
+#include "LVMemory.h"
+#include <string.h>
+
+//数据按8字节对齐
+#define LV_ARENA_ALIGN(SIZE) (((SIZE) + 7) & ~(uint32_t)7)
+
+//块组头部的对齐大小
+#define LV_ARENA_CHUNK_HEADER LV_ARENA_ALIGN(sizeof(Chunk))
+
+LVMemoryArena * LVMemoryArena::s_active = nullptr;
+LVMemoryArena * LVMemoryArena::s_arenaList = nullptr;
+const uint8_t * LVMemoryArena::s_lowest = nullptr;
+const uint8_t * LVMemoryArena::s_highest = nullptr;
+
+LVMemoryArena::LVMemoryArena(uint32_t chunkSize)
+    :m_chunkSize(chunkSize)
+{
+    m_next = s_arenaList;
+    s_arenaList = this;
+}
+
+LVMemoryArena::~LVMemoryArena()
+{
+    if(m_liveCount)
+        lvWarn("LVMemoryArena(0x%p) destroyed with %d allocations alive.",this,m_liveCount);
+
+    end();
+    freeChunks();
+
+    //从内存区链表中移除
+    LVMemoryArena ** link = &s_arenaList;
+    while (*link)
+    {
+        if(*link == this)
+        {
+            *link = m_next;
+            break;
+        }
+        link = &(*link)->m_next;
+    }
+}
+
+bool LVMemoryArena::begin()
+{
+    if(s_active == this)
+        return true;
+    //上一轮的块组还被存活的分配占着,不在上面继续累积
+    if(m_releasePending)
+    {
+        lvWarn("LVMemoryArena(0x%p) release pending with %d allocations alive, not used.",this,m_liveCount);
+        return false;
+    }
+    m_prevActive = s_active;
+    s_active = this;
+    return true;
+}
+
+void LVMemoryArena::end()
+{
+    if(s_active != this)
+        return;
+    s_active = m_prevActive;
+    m_prevActive = nullptr;
+}
+
+void *LVMemoryArena::allocate(uint32_t size)
+{
+    uint32_t need = sizeof(Header) + LV_ARENA_ALIGN(size);
+    Chunk * chunk = m_chunkList;
+
+    if(chunk == nullptr || chunk->size - chunk->used < need)
+    {
+        //大的分配单独占一个块组,不打断当前块组的切分
+        uint32_t chunkSize = need > m_chunkSize ? need : m_chunkSize;
+        chunk = static_cast<Chunk *>(lv_mem_alloc(LV_ARENA_CHUNK_HEADER + chunkSize));
+        if(chunk == nullptr)
+        {
+            lvError("LVMemoryArena(0x%p) out of memory, size : %d",this,size);
+            return nullptr;
+        }
+        chunk->size = chunkSize;
+        chunk->used = 0;
+
+        //只扩大不缩小,范围内的地址前面总是LVGL堆中的数据
+        const uint8_t * first = reinterpret_cast<const uint8_t *>(chunk) + LV_ARENA_CHUNK_HEADER;
+        if(s_lowest == nullptr || first < s_lowest)
+            s_lowest = first;
+        if(first + chunkSize > s_highest)
+            s_highest = first + chunkSize;
+
+        if(need > m_chunkSize && m_chunkList)
+        {
+            chunk->next = m_chunkList->next;
+            m_chunkList->next = chunk;
+        }
+        else
+        {
+            chunk->next = m_chunkList;
+            m_chunkList = chunk;
+        }
+    }
+
+    Header * header = reinterpret_cast<Header *>(reinterpret_cast<uint8_t *>(chunk) + LV_ARENA_CHUNK_HEADER + chunk->used);
+    header->owner = this;
+    header->size = size;
+    header->tag = makeTag(header);
+    chunk->used += need;
+
+    ++m_liveCount;
+    m_liveSize += size;
+    return header + 1;
+}
+
+void *LVMemoryArena::reallocate(void *data, uint32_t size)
+{
+    if(data == nullptr)
+        return allocate(size);
+
+    Header * header = static_cast<Header *>(data) - 1;
+    uint32_t oldSize = header->size;
+    if(size <= LV_ARENA_ALIGN(oldSize))
+    {
+        m_liveSize = m_liveSize - oldSize + size;
+        header->size = size;
+        return data;
+    }
+
+    //当前块组最后一次分配,尝试原地扩展
+    Chunk * chunk = m_chunkList;
+    uint8_t * end = reinterpret_cast<uint8_t *>(chunk) + LV_ARENA_CHUNK_HEADER + chunk->used;
+    uint32_t grow = LV_ARENA_ALIGN(size) - LV_ARENA_ALIGN(oldSize);
+    if(static_cast<uint8_t *>(data) + LV_ARENA_ALIGN(oldSize) == end && chunk->size - chunk->used >= grow)
+    {
+        chunk->used += grow;
+        m_liveSize = m_liveSize - oldSize + size;
+        header->size = size;
+        return data;
+    }
+
+    void * newData = allocate(size);
+    if(newData)
+    {
+        memcpy(newData,data,oldSize);
+        free(data);
+    }
+    return newData;
+}
+
+void LVMemoryArena::free(const void *data)
+{
+    if(data == nullptr)
+        return;
+
+    Header * header = static_cast<Header *>(const_cast<void *>(data)) - 1;
+    m_liveSize -= header->size;
+    //块组归还后可能被LVGL重用,清除标记
+    header->tag = 0;
+    if(--m_liveCount)
+        return;
+
+    //最后一个分配释放,执行推迟的归还
+    if(m_deletePending)
+        delete this;
+    else if(m_releasePending)
+        release();
+    else
+        rewind();
+}
+
+bool LVMemoryArena::release()
+{
+    if(m_liveCount)
+    {
+        m_releasePending = true;
+        return false;
+    }
+    freeChunks();
+    m_releasePending = false;
+    return true;
+}
+
+void LVMemoryArena::drop()
+{
+    end();
+    if(m_liveCount)
+        m_deletePending = true;
+    else
+        delete this;
+}
+
+bool LVMemoryArena::contains(const void *data) const
+{
+    const uint8_t * addr = static_cast<const uint8_t *>(data);
+    for (Chunk * chunk = m_chunkList; chunk; chunk = chunk->next)
+    {
+        const uint8_t * first = reinterpret_cast<const uint8_t *>(chunk) + LV_ARENA_CHUNK_HEADER;
+        if(addr >= first && addr < first + chunk->used)
+            return true;
+    }
+    return false;
+}
+
+uint32_t LVMemoryArena::chunkCount() const
+{
+    uint32_t count = 0;
+    for (Chunk * chunk = m_chunkList; chunk; chunk = chunk->next)
+        ++count;
+    return count;
+}
+
+uint32_t LVMemoryArena::totalSize() const
+{
+    uint32_t size = 0;
+    for (Chunk * chunk = m_chunkList; chunk; chunk = chunk->next)
+        size += LV_ARENA_CHUNK_HEADER + chunk->size;
+    return size;
+}
+
+void LVMemoryArena::freeChunks()
+{
+    Chunk * chunk = m_chunkList;
+    while (chunk)
+    {
+        Chunk * next = chunk->next;
+        lv_mem_free(chunk);
+        chunk = next;
+    }
+    m_chunkList = nullptr;
+}
+
+void LVMemoryArena::rewind()
+{
+    Chunk * chunk = m_chunkList;
+    if(chunk == nullptr)
+        return;
+
+    //单独占一个块组的大分配不保留
+    Chunk * next = chunk->next;
+    chunk->next = nullptr;
+    chunk->used = 0;
+    m_chunkList = chunk;
+    if(chunk->size > m_chunkSize)
+    {
+        lv_mem_free(chunk);
+        m_chunkList = nullptr;
+    }
+    while (next)
+    {
+        chunk = next->next;
+        lv_mem_free(next);
+        next = chunk;
+    }
+}
@@ -0,0 +1,221 @@
+/**
+ * @file LVMemoryArena.h
+ *
+ */
+
+#ifndef LVMEMORYARENA_H
+#define LVMEMORYARENA_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <lv_misc/lv_mem.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 内存区每次向LVGL申请的字节数
+ */
+#ifndef LV_MEMORY_ARENA_CHUNK_SIZE
+#define LV_MEMORY_ARENA_CHUNK_SIZE 2048
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @brief 整块释放的内存区
+ * 在 begin() 和 end() 之间,经 LVMemory (包括 LV_MEMORY 类)的分配都从内存区中顺序切分,
+ * 单独释放只计数,不回收空间;所有分配都释放后,release() 一次性把整个内存区还给LVGL,
+ * 没有调用 release() 时从第一个块组重新切分.
+ *
+ * 适合生命周期一致的一批对象,比如一个屏幕的所有控件.
+ * LVGL内部直接调用 lv_mem_alloc 的分配(如标签文本)不经过内存区.
+ *
+ * NOTE: 非线程安全,只能在GUI线程中使用
+ */
+class LVMemoryArena
+{
+    /**
+     * @brief 内存块组的头部,后面紧跟着分配的数据
+     */
+    struct Chunk
+    {
+        Chunk * next;
+        uint32_t size; //!< 数据区字节数
+        uint32_t used; //!< 已切分的字节数
+    };
+
+    /**
+     * @brief 每次分配的头部,记录所属的内存区和分配的大小
+     * tag 由内存区和头部地址算出,释放地址时不用遍历内存区就能判断归属
+     */
+    struct alignas(8) Header
+    {
+        LVMemoryArena * owner;
+        uint32_t size;
+        uint32_t tag;
+    };
+
+    static uint32_t makeTag(const Header * header)
+    {
+        return 0x4C564152u ^ (uint32_t)(uintptr_t)header ^ (uint32_t)(uintptr_t)header->owner;
+    }
+
+protected:
+    Chunk * m_chunkList = nullptr;          //!< 块组链表,头部是正在切分的块组
+    uint32_t m_chunkSize;                   //!< 每次申请的块组大小
+    uint32_t m_liveCount = 0;               //!< 未释放的分配数量
+    uint32_t m_liveSize = 0;                //!< 未释放的分配字节数
+    bool m_releasePending = false;          //!< 所有分配释放后自动归还
+    bool m_deletePending = false;           //!< 所有分配释放后自动删除
+    LVMemoryArena * m_prevActive = nullptr; //!< 嵌套使用时外层的内存区
+    LVMemoryArena * m_next = nullptr;       //!< 所有内存区的链表
+
+    static LVMemoryArena * s_active;        //!< 正在使用的内存区
+    static LVMemoryArena * s_arenaList;     //!< 所有内存区
+    static const uint8_t * s_lowest;        //!< 申请过的块组数据区的最低地址
+    static const uint8_t * s_highest;       //!< 申请过的块组数据区的最高地址
+
+public:
+    //内存区本身直接在LVGL堆上分配,不进入其他内存区
+    static void* operator new(size_t sz) { return lv_mem_alloc(sz); }
+    static void operator delete(void* p) { lv_mem_free(p); }
+
+    LVMemoryArena(uint32_t chunkSize = LV_MEMORY_ARENA_CHUNK_SIZE);
+
+    ~LVMemoryArena();
+
+    /**
+     * @brief 开始使用这个内存区,可以嵌套
+     * 上一次 release() 还在等待未释放的分配时不使用内存区,分配直接在LVGL堆上
+     * @return 是否开始使用
+     */
+    bool begin();
+
+    /**
+     * @brief 停止使用这个内存区,恢复外层的内存区
+     */
+    void end();
+
+    /**
+     * @brief 从内存区中分配
+     * @param size
+     * @return 内存不足时返回nullptr
+     */
+    void * allocate(uint32_t size);
+
+    /**
+     * @brief 重新分配,最后一次分配可以原地扩展
+     * @param data 属于这个内存区的地址
+     * @param size
+     * @return
+     */
+    void * reallocate(void * data,uint32_t size);
+
+    /**
+     * @brief 释放一次分配,只计数
+     * @param data
+     */
+    void free(const void * data);
+
+    /**
+     * @brief 将整个内存区归还给LVGL
+     * 仍有分配未释放时推迟到全部释放之后
+     * @return true 已归还 ; false 推迟归还
+     */
+    bool release();
+
+    /**
+     * @brief 不再使用这个内存区,全部分配释放后自动删除
+     */
+    void drop();
+
+    /**
+     * @brief 地址是否属于这个内存区
+     * @param data
+     * @return
+     */
+    bool contains(const void * data) const;
+
+    uint32_t liveCount() const { return m_liveCount; }
+    uint32_t liveSize() const { return m_liveSize; }
+    uint32_t chunkCount() const;
+    uint32_t totalSize() const;
+
+    /**
+     * @brief 分配的大小
+     * @param data
+     * @return
+     */
+    static uint32_t getSize(const void * data)
+    {
+        return (static_cast<const Header *>(data) - 1)->size;
+    }
+
+    /**
+     * @brief 正在使用的内存区
+     * @return
+     */
+    static LVMemoryArena * active() { return s_active; }
+
+    /**
+     * @brief 暂停使用内存区,用于创建生命周期更长的对象(如全局单例)
+     * @return 被暂停的内存区,交给 resume() 恢复
+     */
+    static LVMemoryArena * suspend()
+    {
+        LVMemoryArena * arena = s_active;
+        s_active = nullptr;
+        return arena;
+    }
+
+    /**
+     * @brief 恢复 suspend() 暂停的内存区
+     * @param arena
+     */
+    static void resume(LVMemoryArena * arena)
+    {
+        s_active = arena;
+    }
+
+    /**
+     * @brief 查找地址所属的内存区,O(1)
+     * 块组地址范围之外的地址直接返回;范围之内不属于内存区的地址,
+     * 头部位置是LVGL堆中前面的块,tag 不会匹配
+     * @param data
+     * @return 不属于任何内存区时返回nullptr
+     */
+    static LVMemoryArena * find(const void * data)
+    {
+        const uint8_t * addr = static_cast<const uint8_t *>(data);
+        if(addr <= s_lowest || addr >= s_highest)
+            return nullptr;
+        const Header * header = static_cast<const Header *>(data) - 1;
+        return header->tag == makeTag(header) ? header->owner : nullptr;
+    }
+
+protected:
+    void freeChunks();
+
+    /**
+     * @brief 所有分配都已释放,保留第一个块组从头切分,归还其他块组
+     */
+    void rewind();
+
+private:
+    LVMemoryArena(const LVMemoryArena&) = delete;
+    LVMemoryArena& operator = (const LVMemoryArena&) = delete;
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif // LVMEMORYARENA_H
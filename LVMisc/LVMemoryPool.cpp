@@ -0,0 +1,84 @@
+#include "LVMemoryPool.h"
+
+LVMemoryPool::LVMemoryPool(uint32_t blockSize, uint16_t blocksPerChunk)
+    :m_blockSize(blockSize)
+    ,m_blocksPerChunk(blocksPerChunk ? blocksPerChunk : 1)
+{
+    //空闲时块内要存放链表指针,并按指针大小对齐
+    if(m_blockSize < sizeof(FreeBlock))
+        m_blockSize = sizeof(FreeBlock);
+    m_blockSize = (m_blockSize + sizeof(void*) - 1) & ~(uint32_t)(sizeof(void*) - 1);
+}
+
+LVMemoryPool::~LVMemoryPool()
+{
+    //静态对象析构顺序不确定,仍在使用的块之后还会被释放,保留块组
+    if(m_usedCount)
+    {
+        lvWarn("LVMemoryPool(0x%p) destroyed with %d blocks in use.",this,m_usedCount);
+        return;
+    }
+
+    Chunk * chunk = m_chunkList;
+    while (chunk)
+    {
+        Chunk * next = chunk->next;
+        lv_mem_free(chunk);
+        chunk = next;
+    }
+}
+
+bool LVMemoryPool::release()
+{
+    if(m_usedCount)
+        return false;
+
+    Chunk * chunk = m_chunkList;
+    while (chunk)
+    {
+        Chunk * next = chunk->next;
+        lv_mem_free(chunk);
+        chunk = next;
+    }
+    m_chunkList = nullptr;
+    m_freeList = nullptr;
+    m_chunkCount = 0;
+    return true;
+}
+
+bool LVMemoryPool::contains(const void *data) const
+{
+    const uint8_t * addr = static_cast<const uint8_t *>(data);
+    for (Chunk * chunk = m_chunkList; chunk; chunk = chunk->next)
+    {
+        const uint8_t * first = reinterpret_cast<const uint8_t *>(chunk + 1);
+        if(addr >= first && addr < first + m_blockSize * m_blocksPerChunk)
+            return true;
+    }
+    return false;
+}
+
+bool LVMemoryPool::expand()
+{
+    //内存池由所有屏幕共用,直接在LVGL堆上分配,不进入屏幕的内存区
+    Chunk * chunk = static_cast<Chunk *>(lv_mem_alloc(chunkSize()));
+    if(chunk == nullptr)
+    {
+        lvError("LVMemoryPool(0x%p) out of memory, block size : %d",this,m_blockSize);
+        return false;
+    }
+
+    chunk->next = m_chunkList;
+    m_chunkList = chunk;
+    ++m_chunkCount;
+
+    //倒序串联,使得分配顺序与地址顺序一致
+    uint8_t * first = reinterpret_cast<uint8_t *>(chunk + 1);
+    for (int i = m_blocksPerChunk - 1; i >= 0; --i)
+    {
+        FreeBlock * block = reinterpret_cast<FreeBlock *>(first + m_blockSize * i);
+        block->next = m_freeList;
+        m_freeList = block;
+    }
+    return true;
+}
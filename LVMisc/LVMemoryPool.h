@@ -0,0 +1,173 @@
+/**
+ * @file LVMemoryPool.h
+ *
+ */
+
+#ifndef LVMEMORYPOOL_H
+#define LVMEMORYPOOL_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+#include "LVMemory.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @brief 固定大小内存块池
+ * 一次从LVGL中申请一整块内存(chunk),切分为等大的内存块,
+ * 空闲内存块用单向链表串联,申请和释放都是O(1),
+ * 不会在LVGL堆中留下大量的小碎片.
+ *
+ * NOTE: 非线程安全,只能在GUI线程中使用
+ */
+class LVMemoryPool
+{
+    LV_MEMORY
+
+    /**
+     * @brief 空闲内存块,复用块本身的空间记录下一个空闲块
+     */
+    struct FreeBlock
+    {
+        FreeBlock * next;
+    };
+
+    /**
+     * @brief 内存块组的头部,后面紧跟着 m_blocksPerChunk 个内存块
+     */
+    struct Chunk
+    {
+        Chunk * next;
+    };
+
+protected:
+    FreeBlock * m_freeList = nullptr; //!< 空闲块链表
+    Chunk * m_chunkList = nullptr;    //!< 已申请的块组链表
+    uint32_t m_blockSize;             //!< 对齐后的块大小
+    uint16_t m_blocksPerChunk;        //!< 每次扩充的块数量
+    uint16_t m_chunkCount = 0;        //!< 块组数量
+    uint32_t m_usedCount = 0;         //!< 已使用的块数量
+    uint32_t m_peakCount = 0;         //!< 使用峰值
+
+public:
+    /**
+     * @brief 构造内存池,不会立即申请内存
+     * @param blockSize 每个内存块的字节数
+     * @param blocksPerChunk 每次扩充时申请的块数量
+     */
+    LVMemoryPool(uint32_t blockSize, uint16_t blocksPerChunk = 16);
+
+    ~LVMemoryPool();
+
+    /**
+     * @brief 申请一个内存块
+     * @return 内存块地址,内存不足时返回nullptr
+     */
+    void * allocate()
+    {
+        if(m_freeList == nullptr && !expand())
+            return nullptr;
+        FreeBlock * block = m_freeList;
+        m_freeList = block->next;
+        if(++m_usedCount > m_peakCount)
+            m_peakCount = m_usedCount;
+        return block;
+    }
+
+    /**
+     * @brief 归还一个内存块
+     * @param data 由allocate()得到的地址
+     */
+    void free(void * data)
+    {
+        if(data == nullptr)
+            return;
+        FreeBlock * block = static_cast<FreeBlock *>(data);
+        block->next = m_freeList;
+        m_freeList = block;
+        --m_usedCount;
+    }
+
+    /**
+     * @brief 所有块都空闲时,将块组归还给LVGL
+     * @return true 已归还 ; false 仍有块在使用
+     */
+    bool release();
+
+    /**
+     * @brief 地址是否属于这个内存池
+     * @param data
+     * @return
+     */
+    bool contains(const void * data) const;
+
+    uint32_t blockSize() const { return m_blockSize; }
+    uint16_t blocksPerChunk() const { return m_blocksPerChunk; }
+    uint16_t chunkCount() const { return m_chunkCount; }
+    uint32_t capacity() const { return uint32_t(m_chunkCount) * m_blocksPerChunk; }
+    uint32_t usedCount() const { return m_usedCount; }
+    uint32_t freeCount() const { return capacity() - m_usedCount; }
+    uint32_t peakCount() const { return m_peakCount; }
+
+    /**
+     * @brief 占用LVGL堆的总字节数
+     * @return
+     */
+    uint32_t totalSize() const { return m_chunkCount * chunkSize(); }
+
+protected:
+    /**
+     * @brief 申请一个新的块组,并将其中的块加入空闲链表
+     * @return
+     */
+    bool expand();
+
+    uint32_t chunkSize() const { return sizeof(Chunk) + m_blockSize * m_blocksPerChunk; }
+
+private:
+    LVMemoryPool(const LVMemoryPool&) = delete;
+    LVMemoryPool& operator = (const LVMemoryPool&) = delete;
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**
+ * @brief 将类的内存分配交给专属的固定块内存池
+ * 与 LV_MEMORY 用法相同,放在类中的第一行,
+ * 派生类大小不一致时退回到LVGL的堆上分配
+ */
+#define LV_MEMORY_POOL(CLASS,COUNT) \
+    public: \
+    static LVMemoryPool & memoryPool() \
+    { \
+        static LVMemoryPool pool(sizeof(CLASS),COUNT); \
+        return pool; \
+    } \
+    static void* operator new(size_t sz) \
+    { \
+        return sz == sizeof(CLASS) ? memoryPool().allocate() : lv_mem_alloc(sz); \
+    } \
+    static void operator delete(void* p, size_t sz) \
+    { \
+        if(sz == sizeof(CLASS)) \
+            memoryPool().free(p); \
+        else \
+            lv_mem_free(p); \
+    } \
+    LV_MEMORY_NEW_ARRAY \
+    LV_MEMORY_DELETE_ARRAY \
+    LV_MEMORY_PLACE \
+    private:
+
+#endif // LVMEMORYPOOL_H
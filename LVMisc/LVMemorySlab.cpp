@@ -0,0 +1,69 @@
+#include "LVMemorySlab.h"
+
+/**
+ * 每级内存池一个块组中的块数量,至少4块
+ */
+#define LV_MEMORY_SLAB_BLOCKS(SIZE) \
+    ((LV_MEMORY_SLAB_CHUNK_SIZE / (SIZE)) > 4 ? (LV_MEMORY_SLAB_CHUNK_SIZE / (SIZE)) : 4)
+
+#define LV_MEMORY_SLAB_POOL(SIZE) { SIZE, LV_MEMORY_SLAB_BLOCKS(SIZE) }
+
+//分级: 8 16 24 32 48 64 96 128 192 256
+const uint8_t LVMemorySlab::s_sizeClassIndex[256 / 8 + 1] =
+{
+    0, 0, 1, 2, 3, 4, 4, 5, 5,          //0 ~ 64
+    6, 6, 6, 6, 7, 7, 7, 7,             //65 ~ 128
+    8, 8, 8, 8, 8, 8, 8, 8,             //129 ~ 192
+    9, 9, 9, 9, 9, 9, 9, 9,             //193 ~ 256
+};
+
+LVMemoryPool *LVMemorySlab::pools()
+{
+    static LVMemoryPool s_pools[SIZE_CLASS_COUNT] =
+    {
+        LV_MEMORY_SLAB_POOL(8),
+        LV_MEMORY_SLAB_POOL(16),
+        LV_MEMORY_SLAB_POOL(24),
+        LV_MEMORY_SLAB_POOL(32),
+        LV_MEMORY_SLAB_POOL(48),
+        LV_MEMORY_SLAB_POOL(64),
+        LV_MEMORY_SLAB_POOL(96),
+        LV_MEMORY_SLAB_POOL(128),
+        LV_MEMORY_SLAB_POOL(192),
+        LV_MEMORY_SLAB_POOL(256),
+    };
+    return s_pools;
+}
+
+uint32_t LVMemorySlab::release()
+{
+    uint32_t size = 0;
+    for (uint8_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+    {
+        LVMemoryPool & p = pool(i);
+        uint32_t total = p.totalSize();
+        if(p.release())
+            size += total;
+    }
+    return size;
+}
+
+void LVMemorySlab::dump()
+{
+    lvInfo("LVMemorySlab size classes:");
+    for (uint8_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+    {
+        LVMemoryPool & p = pool(i);
+        if(p.chunkCount() == 0)
+            continue;
+        lvInfo("  [%4d] used:%d/%d peak:%d chunks:%d bytes:%d",
+               p.blockSize(),p.usedCount(),p.capacity(),p.peakCount(),p.chunkCount(),p.totalSize());
+    }
+
+    lvInfo("LVMemorySlab classes:");
+    for (LVMemoryClass * cls = LVMemoryClass::first(); cls; cls = cls->next())
+    {
+        lvInfo("  %.*s used:%d peak:%d bytes:%d allocs:%d",
+               cls->nameLength(),cls->name(),cls->usedCount(),cls->peakCount(),cls->usedSize(),cls->allocCount());
+    }
+}
@@ -0,0 +1,178 @@
+/**
+ * @file LVMemorySlab.h
+ *
+ */
+
+#ifndef LVMEMORYSLAB_H
+#define LVMEMORYSLAB_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+#include "LVMemory.h"
+#include "LVMemoryPool.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 是否启用分级内存块分配,为0时 LV_MEMORY_SLAB 等同于 LV_MEMORY
+ */
+#ifndef LV_USE_MEMORY_SLAB
+#define LV_USE_MEMORY_SLAB 1
+#endif
+
+/**
+ * 分级内存块的最大字节数,更大的对象直接在LVGL堆上分配
+ * 不能超过最大的分级(256)
+ */
+#ifndef LV_MEMORY_SLAB_MAX_SIZE
+#define LV_MEMORY_SLAB_MAX_SIZE 256
+#endif
+
+#if LV_MEMORY_SLAB_MAX_SIZE > 256
+#error "LV_MEMORY_SLAB_MAX_SIZE can not exceed the largest size class (256)"
+#endif
+
+/**
+ * 每个内存块组的大致字节数
+ */
+#ifndef LV_MEMORY_SLAB_CHUNK_SIZE
+#define LV_MEMORY_SLAB_CHUNK_SIZE 512
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @brief 分级内存块分配器
+ * 按对象大小分为若干级,每一级是一个固定块内存池,
+ * 大小相近的小对象共用同一级,不会在LVGL堆中留下大量碎片.
+ *
+ * NOTE: 非线程安全,只能在GUI线程中使用
+ */
+class LVMemorySlab
+{
+    LVMemorySlab() = delete;
+    ~LVMemorySlab() = delete;
+public:
+    /**
+     * @brief 分级的数量
+     */
+    static constexpr uint8_t SIZE_CLASS_COUNT = 10;
+
+    /**
+     * @brief 按大小分配内存
+     * @param size 字节数
+     * @param cls 分配所属的类,可以为空
+     * @return
+     */
+    static void * allocate(size_t size,LVMemoryClass * cls = nullptr)
+    {
+        LVMemoryPool * pool = sizeClass(size);
+        //类的统计由这里记录,大对象也不再记到 LVMemoryTrace 的原始分配中
+        void * data = pool ? pool->allocate() : LVMemory::allocateUntraced(size);
+        if(data && cls)
+            cls->onAllocate(size);
+        return data;
+    }
+
+    /**
+     * @brief 释放内存,大小必须与分配时一致
+     * @param data
+     * @param size
+     * @param cls
+     */
+    static void free(void * data,size_t size,LVMemoryClass * cls = nullptr)
+    {
+        if(data == nullptr)
+            return;
+        LVMemoryPool * pool = sizeClass(size);
+        if(pool)
+            pool->free(data);
+        else
+            LVMemory::free(data);
+        if(cls)
+            cls->onFree(size);
+    }
+
+    /**
+     * @brief 获取大小对应的内存池
+     * @param size
+     * @return 超过 LV_MEMORY_SLAB_MAX_SIZE 时返回nullptr
+     */
+    static LVMemoryPool * sizeClass(size_t size)
+    {
+        if(size > LV_MEMORY_SLAB_MAX_SIZE)
+            return nullptr;
+        return &pools()[s_sizeClassIndex[(size + 7) >> 3]];
+    }
+
+    /**
+     * @brief 获取某一级的内存池
+     * @param index [0,SIZE_CLASS_COUNT)
+     * @return
+     */
+    static LVMemoryPool & pool(uint8_t index) { return pools()[index]; }
+
+    /**
+     * @brief 注册过的类链表
+     * @return
+     */
+    static LVMemoryClass * firstClass() { return LVMemoryClass::first(); }
+
+    /**
+     * @brief 将空闲的内存池归还给LVGL
+     * @return 归还的字节数
+     */
+    static uint32_t release();
+
+    /**
+     * @brief 输出各级内存池和各个类的占用情况
+     */
+    static void dump();
+
+protected:
+    static LVMemoryPool * pools();
+
+    static const uint8_t s_sizeClassIndex[256 / 8 + 1]; //!< 8字节为单位的大小到分级的映射
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#if LV_USE_MEMORY_SLAB
+/**
+ * @brief 将类的内存分配交给分级内存块分配器,并统计类的占用
+ * 与 LV_MEMORY 用法相同,放在类中的第一行,
+ * 派生类没有使用时,统计在基类中
+ */
+#define LV_MEMORY_SLAB \
+    public: \
+    static LVMemoryClass & memoryClass() \
+    { \
+        static LVMemoryClass cls(__PRETTY_FUNCTION__); \
+        return cls; \
+    } \
+    static void* operator new(size_t sz) \
+    { \
+        return LVMemorySlab::allocate(sz,&memoryClass()); \
+    } \
+    static void operator delete(void* p, size_t sz) \
+    { \
+        LVMemorySlab::free(p,sz,&memoryClass()); \
+    } \
+    LV_MEMORY_NEW_ARRAY \
+    LV_MEMORY_DELETE_ARRAY \
+    LV_MEMORY_PLACE \
+    private:
+#else
+#define LV_MEMORY_SLAB LV_MEMORY
+#endif
+
+#endif // LVMEMORYSLAB_H
@@ -0,0 +1,348 @@
+#include "LVMemoryTrace.h"
+#include "LVMemory.h"
+#include <string.h>
+
+bool LVMemoryTrace::s_enabled = false;
+LVMemoryTrace::Entry * LVMemoryTrace::s_table = nullptr;
+uint32_t LVMemoryTrace::s_capacity = 0;
+uint32_t LVMemoryTrace::s_liveCount = 0;
+uint32_t LVMemoryTrace::s_liveSize = 0;
+uint32_t LVMemoryTrace::s_peakSize = 0;
+uint32_t LVMemoryTrace::s_droppedCount = 0;
+uint32_t LVMemoryTrace::s_histogram[HISTOGRAM_SIZE] = {0};
+uint32_t LVMemoryTrace::s_histogramTotal[HISTOGRAM_SIZE] = {0};
+LVMemoryTrace::Scope LVMemoryTrace::s_scopes[LV_MEMORY_TRACE_SCOPE_COUNT];
+uint8_t LVMemoryTrace::s_scopeCount = 1; //第一个作用域不属于任何屏幕
+uint8_t LVMemoryTrace::s_currScope = 0;
+
+/**
+ * @brief 没有指定类的分配(直接调用 LVMemory)
+ */
+static LVMemoryClass & rawClass()
+{
+    static LVMemoryClass cls("LVMemory::memoryClass");
+    return cls;
+}
+
+static inline uint32_t hashOf(const void * data,uint32_t capacity)
+{
+    return (uint32_t)((reinterpret_cast<uintptr_t>(data) >> 3) * 2654435761u) & (capacity - 1);
+}
+
+void LVMemoryTrace::setEnabled(bool value)
+{
+    if(s_enabled == value)
+        return;
+    //重新开始记录,关闭期间的分配无法对应
+    reset();
+    s_enabled = value;
+}
+
+void LVMemoryTrace::setScope(const char *name)
+{
+    if(name == nullptr || name[0] == '\0')
+    {
+        s_currScope = 0;
+        return;
+    }
+
+    for (uint8_t i = 1; i < s_scopeCount; ++i)
+    {
+        if(strncmp(s_scopes[i].name,name,LV_MEMORY_TRACE_NAME_SIZE - 1) == 0)
+        {
+            s_currScope = i;
+            return;
+        }
+    }
+
+    //作用域已满,统计到第一个作用域中
+    if(s_scopeCount == LV_MEMORY_TRACE_SCOPE_COUNT)
+    {
+        s_currScope = 0;
+        return;
+    }
+
+    Scope & scope = s_scopes[s_scopeCount];
+    memset(&scope,0,sizeof(Scope));
+    strncpy(scope.name,name,LV_MEMORY_TRACE_NAME_SIZE - 1);
+    s_currScope = s_scopeCount++;
+}
+
+const char *LVMemoryTrace::scope()
+{
+    return s_scopes[s_currScope].name;
+}
+
+void LVMemoryTrace::onAllocate(const void *data, uint32_t size, LVMemoryClass *owner)
+{
+    Entry * entry = insert(data);
+    if(entry == nullptr)
+    {
+        ++s_droppedCount;
+        return;
+    }
+    entry->owner = owner ? owner : &rawClass();
+    entry->size = size;
+    entry->scope = s_currScope;
+    account(entry,true);
+}
+
+void LVMemoryTrace::onReallocate(const void *oldData, const void *data, uint32_t size)
+{
+    Entry * entry = find(oldData);
+    if(entry == nullptr)
+    {
+        onAllocate(data,size,nullptr);
+        return;
+    }
+
+    //保留原来的类和作用域
+    LVMemoryClass * owner = entry->owner;
+    uint8_t scope = entry->scope;
+    account(entry,false);
+    remove(entry);
+
+    entry = insert(data);
+    if(entry == nullptr)
+    {
+        ++s_droppedCount;
+        return;
+    }
+    entry->owner = owner;
+    entry->size = size;
+    entry->scope = scope;
+    account(entry,true);
+}
+
+void LVMemoryTrace::onFree(const void *data)
+{
+    //开启跟踪之前的分配没有记录
+    Entry * entry = find(data);
+    if(entry == nullptr)
+        return;
+    account(entry,false);
+    remove(entry);
+}
+
+uint32_t LVMemoryTrace::histogram(uint8_t bucket)
+{
+    return bucket < HISTOGRAM_SIZE ? s_histogram[bucket] : 0;
+}
+
+uint32_t LVMemoryTrace::histogramTotal(uint8_t bucket)
+{
+    return bucket < HISTOGRAM_SIZE ? s_histogramTotal[bucket] : 0;
+}
+
+uint32_t LVMemoryTrace::bucketLimit(uint8_t bucket)
+{
+    return bucket + 1 < HISTOGRAM_SIZE ? (8u << bucket) : UINT32_MAX;
+}
+
+const LVMemoryTrace::Scope &LVMemoryTrace::scopeAt(uint8_t index)
+{
+    return s_scopes[index < s_scopeCount ? index : 0];
+}
+
+uint8_t LVMemoryTrace::topClasses(LVMemoryClass **classes, uint8_t count)
+{
+    uint8_t n = 0;
+    for (LVMemoryClass * cls = LVMemoryClass::first(); cls; cls = cls->next())
+    {
+        if(cls->usedSize() == 0)
+            continue;
+
+        //插入排序,保留前count个
+        uint8_t i = n < count ? n++ : count;
+        while (i > 0 && classes[i - 1]->usedSize() < cls->usedSize())
+        {
+            if(i < count)
+                classes[i] = classes[i - 1];
+            --i;
+        }
+        if(i < count)
+            classes[i] = cls;
+    }
+    return n;
+}
+
+void LVMemoryTrace::dump(uint8_t top)
+{
+    lvInfo("LVMemoryTrace live:%d bytes:%d peak:%d dropped:%d",
+           s_liveCount,s_liveSize,s_peakSize,s_droppedCount);
+
+    lvInfo("LVMemoryTrace size histogram:");
+    for (uint8_t i = 0; i < HISTOGRAM_SIZE; ++i)
+    {
+        if(s_histogramTotal[i] == 0)
+            continue;
+        if(i + 1 < HISTOGRAM_SIZE)
+        {
+            lvInfo("  <=%5d live:%d total:%d",bucketLimit(i),s_histogram[i],s_histogramTotal[i]);
+        }
+        else
+        {
+            lvInfo("  > %5d live:%d total:%d",bucketLimit(i - 1),s_histogram[i],s_histogramTotal[i]);
+        }
+    }
+
+    lvInfo("LVMemoryTrace screens:");
+    for (uint8_t i = 0; i < s_scopeCount; ++i)
+    {
+        const Scope & scope = s_scopes[i];
+        lvInfo("  [%s] live:%d bytes:%d peak:%d allocs:%d",
+               i ? scope.name : "-",scope.liveCount,scope.liveSize,scope.peakSize,scope.allocCount);
+    }
+
+    LVMemoryClass * classes[32];
+    if(top > 32)
+        top = 32;
+    if(top == 0)
+        return;
+    uint8_t n = topClasses(classes,top);
+    lvInfo("LVMemoryTrace top %d classes:",n);
+    for (uint8_t i = 0; i < n; ++i)
+    {
+        LVMemoryClass * cls = classes[i];
+        lvInfo("  %.*s live:%d bytes:%d peak:%d allocs:%d",
+               cls->nameLength(),cls->name(),cls->usedCount(),cls->usedSize(),cls->peakCount(),cls->allocCount());
+    }
+}
+
+void LVMemoryTrace::reset()
+{
+    //先减去类中的统计
+    for (uint32_t i = 0; i < s_capacity; ++i)
+    {
+        if(s_table[i].data)
+            s_table[i].owner->onFree(s_table[i].size);
+    }
+
+    lv_mem_free(s_table);
+    s_table = nullptr;
+    s_capacity = 0;
+    s_liveCount = 0;
+    s_liveSize = 0;
+    s_peakSize = 0;
+    s_droppedCount = 0;
+    memset(s_histogram,0,sizeof(s_histogram));
+    memset(s_histogramTotal,0,sizeof(s_histogramTotal));
+    memset(s_scopes,0,sizeof(s_scopes));
+    s_scopeCount = 1;
+    s_currScope = 0;
+}
+
+LVMemoryTrace::Entry *LVMemoryTrace::find(const void *data)
+{
+    if(s_capacity == 0)
+        return nullptr;
+    uint32_t mask = s_capacity - 1;
+    for (uint32_t i = hashOf(data,s_capacity); s_table[i].data; i = (i + 1) & mask)
+    {
+        if(s_table[i].data == data)
+            return &s_table[i];
+    }
+    return nullptr;
+}
+
+LVMemoryTrace::Entry *LVMemoryTrace::insert(const void *data)
+{
+    //装载率不超过3/4
+    if((s_liveCount + 1) * 4 > s_capacity * 3 && !grow())
+        return nullptr;
+
+    uint32_t mask = s_capacity - 1;
+    uint32_t i = hashOf(data,s_capacity);
+    while (s_table[i].data)
+        i = (i + 1) & mask;
+    s_table[i].data = data;
+    return &s_table[i];
+}
+
+void LVMemoryTrace::remove(Entry *entry)
+{
+    //线性探测的删除:把后面的记录向前移动,保持探测链连续
+    uint32_t mask = s_capacity - 1;
+    uint32_t i = entry - s_table;
+    uint32_t j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if(s_table[j].data == nullptr)
+            break;
+        uint32_t k = hashOf(s_table[j].data,s_capacity);
+        //k 在 (i,j] 之间的记录不需要移动
+        if(i <= j ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+        s_table[i] = s_table[j];
+        i = j;
+    }
+    s_table[i].data = nullptr;
+}
+
+bool LVMemoryTrace::grow()
+{
+    uint32_t capacity = s_capacity ? s_capacity * 2 : 256;
+    //跟踪表直接在LVGL堆上分配,不经过 LVMemory
+    Entry * table = static_cast<Entry *>(lv_mem_alloc(capacity * sizeof(Entry)));
+    if(table == nullptr)
+        return false;
+    memset(table,0,capacity * sizeof(Entry));
+
+    Entry * oldTable = s_table;
+    uint32_t oldCapacity = s_capacity;
+    s_table = table;
+    s_capacity = capacity;
+
+    for (uint32_t i = 0; i < oldCapacity; ++i)
+    {
+        if(oldTable[i].data == nullptr)
+            continue;
+        uint32_t j = hashOf(oldTable[i].data,capacity);
+        while (table[j].data)
+            j = (j + 1) & (capacity - 1);
+        table[j] = oldTable[i];
+    }
+    lv_mem_free(oldTable);
+    return true;
+}
+
+uint8_t LVMemoryTrace::bucketOf(uint32_t size)
+{
+    uint8_t bucket = 0;
+    while (bucket + 1 < HISTOGRAM_SIZE && size > (8u << bucket))
+        ++bucket;
+    return bucket;
+}
+
+void LVMemoryTrace::account(Entry *entry, bool add)
+{
+    Scope & scope = s_scopes[entry->scope];
+    uint8_t bucket = bucketOf(entry->size);
+    if(add)
+    {
+        ++s_liveCount;
+        s_liveSize += entry->size;
+        if(s_liveSize > s_peakSize)
+            s_peakSize = s_liveSize;
+
+        ++scope.liveCount;
+        ++scope.allocCount;
+        scope.liveSize += entry->size;
+        if(scope.liveSize > scope.peakSize)
+            scope.peakSize = scope.liveSize;
+
+        ++s_histogram[bucket];
+        ++s_histogramTotal[bucket];
+        entry->owner->onAllocate(entry->size);
+    }
+    else
+    {
+        --s_liveCount;
+        s_liveSize -= entry->size;
+        --scope.liveCount;
+        scope.liveSize -= entry->size;
+        --s_histogram[bucket];
+        entry->owner->onFree(entry->size);
+    }
+}
@@ -0,0 +1,183 @@
+/**
+ * @file LVMemoryTrace.h
+ *
+ */
+
+#ifndef LVMEMORYTRACE_H
+#define LVMEMORYTRACE_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 最多统计的屏幕(作用域)数量,超出的统计到第一个作用域中
+ */
+#ifndef LV_MEMORY_TRACE_SCOPE_COUNT
+#define LV_MEMORY_TRACE_SCOPE_COUNT 16
+#endif
+
+/**
+ * 作用域名称保留的最大长度
+ */
+#ifndef LV_MEMORY_TRACE_NAME_SIZE
+#define LV_MEMORY_TRACE_NAME_SIZE 16
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+class LVMemoryClass;
+
+/**
+ * @brief 内存分配跟踪
+ * 记录经 LVMemory 的每一次分配/重新分配/释放:
+ * 大小,所属的类(来自 LV_MEMORY),分配时所在的屏幕(作用域).
+ * 提供存活分配的大小分布,每个屏幕的峰值,占用最多的类,
+ * 以及通过 LVLog 输出的报告.
+ *
+ * 需要编译时开启 LV_USE_MEMORY_TRACE,并在运行时 setEnabled(true).
+ * 跟踪表本身直接在LVGL堆上分配,不计入统计.
+ *
+ * NOTE: 非线程安全,只能在GUI线程中使用
+ */
+class LVMemoryTrace
+{
+    LVMemoryTrace() = delete;
+    ~LVMemoryTrace() = delete;
+public:
+    /**
+     * @brief 大小分布的分级数量
+     * [0,8] (8,16] (16,32] ... (2048,4096] (4096,...)
+     */
+    static constexpr uint8_t HISTOGRAM_SIZE = 11;
+
+    /**
+     * @brief 一个作用域(屏幕)的统计
+     */
+    struct Scope
+    {
+        char name[LV_MEMORY_TRACE_NAME_SIZE]; //!< 作用域名称
+        uint32_t liveCount;  //!< 存活的分配数量
+        uint32_t liveSize;   //!< 存活的分配字节数
+        uint32_t peakSize;   //!< 存活字节数峰值
+        uint32_t allocCount; //!< 累计分配次数
+    };
+
+    static void setEnabled(bool value);
+    static bool isEnabled() { return s_enabled; }
+
+    /**
+     * @brief 设置当前的作用域,之后的分配都记在这个作用域中
+     * @param name 屏幕名称,nullptr 表示不属于任何屏幕
+     */
+    static void setScope(const char * name);
+
+    /**
+     * @brief 当前作用域的名称
+     * @return
+     */
+    static const char * scope();
+
+    static void onAllocate(const void * data,uint32_t size,LVMemoryClass * owner);
+    static void onReallocate(const void * oldData,const void * data,uint32_t size);
+    static void onFree(const void * data);
+
+    static uint32_t liveCount() { return s_liveCount; }
+    static uint32_t liveSize() { return s_liveSize; }
+    static uint32_t peakSize() { return s_peakSize; }
+
+    /**
+     * @brief 丢失的记录数量(跟踪表内存不足)
+     * @return
+     */
+    static uint32_t droppedCount() { return s_droppedCount; }
+
+    /**
+     * @brief 存活分配的大小分布
+     * @param bucket [0,HISTOGRAM_SIZE)
+     * @return 这一级的存活分配数量
+     */
+    static uint32_t histogram(uint8_t bucket);
+
+    /**
+     * @brief 这一级累计的分配次数
+     * @param bucket
+     * @return
+     */
+    static uint32_t histogramTotal(uint8_t bucket);
+
+    /**
+     * @brief 这一级的上限字节数
+     * @param bucket
+     * @return 最后一级返回 UINT32_MAX
+     */
+    static uint32_t bucketLimit(uint8_t bucket);
+
+    static uint8_t scopeCount() { return s_scopeCount; }
+    static const Scope & scopeAt(uint8_t index);
+
+    /**
+     * @brief 存活字节数最多的类
+     * @param classes 输出的数组
+     * @param count 数组大小
+     * @return 实际输出的数量
+     */
+    static uint8_t topClasses(LVMemoryClass ** classes,uint8_t count);
+
+    /**
+     * @brief 通过 LVLog 输出报告
+     * @param top 输出占用最多的类的数量
+     */
+    static void dump(uint8_t top = 10);
+
+    /**
+     * @brief 清除所有记录和统计
+     */
+    static void reset();
+
+protected:
+    /**
+     * @brief 一条存活分配的记录
+     */
+    struct Entry
+    {
+        const void * data;
+        LVMemoryClass * owner;
+        uint32_t size;
+        uint8_t scope;
+    };
+
+    static Entry * find(const void * data);
+    static Entry * insert(const void * data);
+    static void remove(Entry * entry);
+    static bool grow();
+    static uint8_t bucketOf(uint32_t size);
+    static void account(Entry * entry,bool add);
+
+    static bool s_enabled;
+    static Entry * s_table;           //!< 开放寻址的记录表
+    static uint32_t s_capacity;       //!< 记录表容量(2的幂)
+    static uint32_t s_liveCount;
+    static uint32_t s_liveSize;
+    static uint32_t s_peakSize;
+    static uint32_t s_droppedCount;
+    static uint32_t s_histogram[HISTOGRAM_SIZE];
+    static uint32_t s_histogramTotal[HISTOGRAM_SIZE];
+    static Scope s_scopes[LV_MEMORY_TRACE_SCOPE_COUNT];
+    static uint8_t s_scopeCount;
+    static uint8_t s_currScope;
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif // LVMEMORYTRACE_H
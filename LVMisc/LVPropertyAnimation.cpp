@@ -0,0 +1,106 @@
+#include "LVPropertyAnimation.h"
+
+#if LV_USE_ANIMATION && LV_USE_POINTER
+
+#include "LVMemoryArena.h"
+
+LVPropertyAnimation * LVPropertyAnimation::s_first = nullptr;
+
+LVPropertyAnimation::LVPropertyAnimation(LVObject *obj, lv_anim_exec_xcb_t exec, Setter setter)
+    : m_object(obj)
+    , m_exec(exec)
+    , m_setter(setter)
+{
+    m_next = s_first;
+    if(s_first)
+        s_first->m_prev = this;
+    s_first = this;
+}
+
+LVPropertyAnimation::~LVPropertyAnimation()
+{
+    if(m_prev)
+        m_prev->m_next = m_next;
+    else
+        s_first = m_next;
+    if(m_next)
+        m_next->m_prev = m_prev;
+}
+
+void LVPropertyAnimation::stopAll(LVObject *obj)
+{
+    LVPropertyAnimation * a = s_first;
+    while (a)
+    {
+        LVPropertyAnimation * next = a->m_next;
+        if(a->m_object.get() == obj)
+            a->cancel();
+        a = next;
+    }
+}
+
+uint32_t LVPropertyAnimation::count()
+{
+    uint32_t n = 0;
+    for (LVPropertyAnimation * a = s_first; a; a = a->m_next)
+        ++n;
+    return n;
+}
+
+LVAnimationGroup *LVPropertyAnimation::group()
+{
+    static LVAnimationGroup * s_group = nullptr;
+    if(s_group == nullptr)
+    {
+        //全局的动画组不进入屏幕内存区
+        LVMemoryArena * arena = LVMemoryArena::suspend();
+        s_group = new LVAnimationGroup;
+        LVMemoryArena::resume(arena);
+        s_group->setReadyCallBack(readyCallBack);
+    }
+    return s_group;
+}
+
+bool LVPropertyAnimation::start(LVObject *obj, lv_anim_exec_xcb_t exec, Setter setter, LVAnimValue from, LVAnimValue to,
+                                uint16_t time, LVAnimPath::Path path, uint16_t delay)
+{
+    if(obj == nullptr)
+        return false;
+
+    //同一个属性的动画合并,从当前值继续
+    LVPropertyAnimation * a = find(obj,exec,setter);
+    if(a == nullptr)
+        a = new LVPropertyAnimation(obj,exec,setter);
+    else if(a->m_started)
+        from = a->m_value;
+
+    group()->add(a,exec,from,to,time,delay,path);
+    return true;
+}
+
+LVPropertyAnimation *LVPropertyAnimation::find(LVObject *obj, lv_anim_exec_xcb_t exec, Setter setter)
+{
+    for (LVPropertyAnimation * a = s_first; a; a = a->m_next)
+    {
+        if(a->m_exec == exec && a->m_setter == setter && a->m_object.get() == obj)
+            return a;
+    }
+    return nullptr;
+}
+
+void LVPropertyAnimation::cancel()
+{
+    //刷新中删除时,动画组在本帧结束时才移除,不会再调用执行函数
+    group()->remove(this,m_exec);
+    delete this;
+}
+
+void LVPropertyAnimation::readyCallBack(LVAnimationGroup * group, void *var, lv_anim_exec_xcb_t exec)
+{
+    //结束的同一帧里执行函数又开始了这个属性的动画,记录被重用,不能删除
+    if(group->contains(var,exec))
+        return;
+    delete static_cast<LVPropertyAnimation *>(var);
+}
+
+#endif // LV_USE_ANIMATION && LV_USE_POINTER
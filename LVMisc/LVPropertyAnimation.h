@@ -0,0 +1,172 @@
+/**
+ * @file LVPropertyAnimation.h
+ *
+ */
+
+#ifndef LVPROPERTYANIMATION_H
+#define LVPROPERTYANIMATION_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "LVAnimationGroup.h"
+#include "../LVCore/LVPointer.h"
+
+#if LV_USE_ANIMATION && LV_USE_POINTER
+
+#include <type_traits>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @brief 对象属性的动画
+ * 直接绑定对象的 set 成员函数,不需要 LVAnimation 和捕获对象的拉姆达:
+ *
+ * LVPropertyAnimation::animate(btn,&LVObject::setX,0,100,300,LVAnimPath::PATH_EASE_OUT);
+ * LVPropertyAnimation::animate(label,&LVObject::setOpaScale,0,255,200);
+ *
+ * 成员函数指针保存在动画中,每种 (类,参数类型) 生成一个执行函数,没有 std::function.
+ * 所有属性动画在同一个 LVAnimationGroup 中运行.
+ * 通过 LVPointer 感知对象的删除,对象删除后的下一帧动画自动取消.
+ * 同一个对象的同一个属性只有一个动画,再次调用时从当前值开始运行到新的结束值.
+ */
+class LVPropertyAnimation
+{
+    LV_MEMORY
+
+public:
+    using Setter = void (LVObject::*)();
+
+protected:
+    LVPointer<LVObject> m_object;           //!< 动画的对象,删除后为空
+    lv_anim_exec_xcb_t m_exec;              //!< 按setter类型生成的执行函数
+    Setter m_setter;                        //!< 成员函数指针(转换为统一类型保存)
+    LVAnimValue m_value = 0;                //!< 最近一次设置的值
+    bool m_started = false;                 //!< 是否已经设置过值
+    LVPropertyAnimation * m_prev = nullptr;
+    LVPropertyAnimation * m_next = nullptr;
+
+    static LVPropertyAnimation * s_first;
+
+    LVPropertyAnimation(LVObject * obj,lv_anim_exec_xcb_t exec,Setter setter);
+    ~LVPropertyAnimation();
+
+public:
+    /**
+     * @brief 运行属性动画
+     * @param obj 对象
+     * @param setter 设置属性的成员函数,比如 &LVObject::setX
+     * @param from 起始值,属性已有运行中的动画时从当前值开始
+     * @param to 结束值
+     * @param time 时长(毫秒)
+     * @param path 路径
+     * @param delay 开始前的延时(毫秒)
+     * @return obj为nullptr时返回false
+     */
+    template<class O,class T,class V>
+    static bool animate(O * obj,void (T::*setter)(V),LVAnimValue from,LVAnimValue to,uint16_t time,
+                        LVAnimPath::Path path = LVAnimPath::PATH_LINEAR,uint16_t delay = 0)
+    {
+        static_assert(std::is_base_of<LVObject,T>::value,"setter must be a member of an LVObject class");
+        static_assert(std::is_base_of<T,O>::value,"object does not have this setter");
+        return start(static_cast<T*>(obj),execSetter<T,V>,reinterpret_cast<Setter>(setter),
+                     from,to,time,path,delay);
+    }
+
+    /**
+     * @brief 停止属性动画,属性保持当前值
+     * @param obj
+     * @param setter
+     * @return 是否有运行中的动画
+     */
+    template<class T,class V>
+    static bool stop(LVObject * obj,void (T::*setter)(V))
+    {
+        LVPropertyAnimation * a = find(obj,execSetter<T,V>,reinterpret_cast<Setter>(setter));
+        if(a)
+            a->cancel();
+        return a != nullptr;
+    }
+
+    /**
+     * @brief 停止对象的所有属性动画
+     * @param obj
+     */
+    static void stopAll(LVObject * obj);
+
+    /**
+     * @brief 属性是否正在运行动画
+     * @param obj
+     * @param setter
+     * @return
+     */
+    template<class T,class V>
+    static bool isRunning(LVObject * obj,void (T::*setter)(V))
+    {
+        return find(obj,execSetter<T,V>,reinterpret_cast<Setter>(setter)) != nullptr;
+    }
+
+    /**
+     * @brief 正在运行的属性动画数量
+     * @return
+     */
+    static uint32_t count();
+
+    /**
+     * @brief 运行属性动画的动画组
+     * @return
+     */
+    static LVAnimationGroup * group();
+
+protected:
+    static bool start(LVObject * obj,lv_anim_exec_xcb_t exec,Setter setter,LVAnimValue from,LVAnimValue to,
+                      uint16_t time,LVAnimPath::Path path,uint16_t delay);
+
+    static LVPropertyAnimation * find(LVObject * obj,lv_anim_exec_xcb_t exec,Setter setter);
+
+    /**
+     * @brief 从动画组中删除并销毁
+     */
+    void cancel();
+
+    /**
+     * @brief 动画结束,销毁
+     */
+    static void readyCallBack(LVAnimationGroup * group,void * var,lv_anim_exec_xcb_t exec);
+
+    /**
+     * @brief 调用成员函数设置属性,对象已删除时取消动画
+     */
+    template<class T,class V>
+    static void execSetter(void * var,LVAnimValue value)
+    {
+        LVPropertyAnimation * a = static_cast<LVPropertyAnimation *>(var);
+        LVObject * obj = a->m_object.get();
+        if(obj == nullptr)
+        {
+            a->cancel();
+            return;
+        }
+        a->m_value = value;
+        a->m_started = true;
+        (static_cast<T*>(obj)->*reinterpret_cast<void (T::*)(V)>(a->m_setter))(static_cast<V>(value));
+    }
+
+private:
+    LVPropertyAnimation(const LVPropertyAnimation&) = delete;
+    LVPropertyAnimation& operator = (const LVPropertyAnimation&) = delete;
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_ANIMATION && LV_USE_POINTER*/
+
+#endif // LVPROPERTYANIMATION_H
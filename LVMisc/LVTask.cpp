@@ -1,4 +1,9 @@
 #include "LVTask.h"
+#include "LVAsyncTask.h"
+#include <lv_misc/lv_gc.h>
+#include <lv_misc/lv_anim.h>
+#include <lv_core/lv_disp.h>
+#include <lv_core/lv_indev.h>
 
 extern "C"
 {
@@ -86,3 +91,108 @@ bool LVTask::isVaild(lv_task_t *task)
     }
 
 }
+
+LVTaskWakeCallBack LVTask::s_wakeCallBack;
+bool LVTask::s_wakeOnInput = false;
+lv_task_t * LVTask::s_animTask = nullptr;
+
+void LVTask::handler()
+{
+#if LV_USE_ASYNC_TASK
+    LVAsyncTask::dispatch();
+#endif
+    lv_task_handler();
+#if LV_USE_TASK_SCHEDULER
+    LVTaskScheduler::handler();
+#endif
+}
+
+uint32_t LVTask::handlerTickless()
+{
+#if LV_USE_ASYNC_TASK
+    LVAsyncTask::dispatch();
+#endif
+    lv_task_handler();
+#if LV_USE_TASK_SCHEDULER
+    uint32_t deadline = LVTaskScheduler::handler();
+#else
+    uint32_t deadline = LV_TASK_NO_DEADLINE;
+#endif
+    //任务中可能开始了动画或使区域无效,最后再计算LVGL的任务
+    uint32_t lvgl = lvglDeadline();
+#if LV_USE_ASYNC_TASK
+    //运行期间后台线程又交回了结果
+    if(LVAsyncTask::hasResult())
+        return 0;
+#endif
+    return lvgl < deadline ? lvgl : deadline;
+}
+
+void LVTask::initTickless()
+{
+    //lv_init() 之后任务列表中只有 lv_anim_core_init() 创建的动画任务
+    lv_task_t * task = static_cast<lv_task_t *>(lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll)));
+    if(task == nullptr || lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll),task) != nullptr)
+    {
+        lvWarn("LVTask::initTickless must be called right after lv_init(), anim task not found.");
+        return;
+    }
+    s_animTask = task;
+}
+
+uint32_t LVTask::lvglDeadline()
+{
+    uint32_t deadline = LV_TASK_NO_DEADLINE;
+    uint16_t animCount = lv_anim_count_running();
+    bool animating = animCount != 0;
+    uint32_t now = lv_tick_get();
+
+    lv_task_t * task = static_cast<lv_task_t *>(lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll)));
+    while (task)
+    {
+        //任务按优先级排列,停止的任务在最后
+        if(task->prio == LV_TASK_PRIO_OFF)
+            break;
+
+        bool waiting = true;
+        if(task == s_animTask)
+        {
+            //LVGL的动画任务
+            waiting = animating;
+        }
+        else
+        {
+            for (lv_disp_t * disp = lv_disp_get_next(nullptr); disp; disp = lv_disp_get_next(disp))
+            {
+                //刷新任务只在有无效区域时等待
+                if(disp->refr_task == task)
+                {
+                    waiting = disp->inv_p != 0;
+                    break;
+                }
+            }
+            if(waiting && s_wakeOnInput)
+            {
+                for (lv_indev_t * indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev))
+                {
+                    if(indev->driver.read_task == task)
+                    {
+                        waiting = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if(waiting)
+        {
+            int32_t remain = (int32_t)(task->last_run + task->period - now);
+            if(remain <= 0)
+                return 0;
+            if((uint32_t)remain < deadline)
+                deadline = remain;
+        }
+        task = static_cast<lv_task_t *>(lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll),task));
+    }
+    return deadline;
+}
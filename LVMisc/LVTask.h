@@ -13,13 +13,33 @@
 
 #include <lv_misc/lv_task.h>
 #include "LVMemory.h"
+#include "LVMemorySlab.h"
 #include "LVLinkList.h"
 #include "../LVCore/LVCallBack.h"
+#include "LVTaskScheduler.h"
+#include "LVTaskProfile.h"
+#include "LVMemoryArena.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/**
+ * 使用 LVTaskScheduler 调度 LVTask,
+ * 为0时 LVTask 与LVGL内部任务一起由 lv_task_handler() 轮询
+ */
+#ifndef LV_USE_TASK_SCHEDULER
+#define LV_USE_TASK_SCHEDULER 0
+#endif
+
+/**
+ * 统计每个任务的运行时间(LVTaskProfile),
+ * 运行时还需要 setProfileEnabled(true) 或 LVTaskProfile::setAutoEnable(true)
+ */
+#ifndef LV_USE_TASK_PROFILE
+#define LV_USE_TASK_PROFILE 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -31,6 +51,11 @@ class LVTask;
  */
 using LVTaskCallBack =  LVCallBack<void(LVTask*),void>;
 
+/**
+ * 唤醒主循环的函数,可能在中断中调用
+ */
+using LVTaskWakeCallBack =  LVCallBack<void(void),void>;
+
 /**
  * Descriptor of a lv_task
  */
@@ -47,8 +72,9 @@ class LVTask
         : public lv_task_t
         , public LVLLNodeMeta<lv_task_t>
 {
-    LV_MEMORY
+    LV_MEMORY_SLAB
 
+    friend class LVTaskScheduler;
 protected:
     LVTaskCallBack m_callBack; //!< 任务执行函数
 
@@ -57,6 +83,13 @@ protected:
 
     uint8_t m_deleteAfterStop :1;//!< 任务停止时清除任务
     uint8_t m_priority:3;       //!< 任务优先级
+#if LV_USE_TASK_SCHEDULER
+    uint8_t m_schedPrio:3;      //!< 所在调度堆的优先级
+    int32_t m_schedIndex = -1;  //!< 在调度堆中的位置,-1表示未运行
+#endif
+#if LV_USE_TASK_PROFILE
+    LVTaskProfile * m_profile = nullptr; //!< 运行统计
+#endif
 
 public:
     /**
@@ -88,11 +121,49 @@ public:
     /**
      * Call it  periodically to handle lv_tasks.
      */
-    static LV_ATTRIBUTE_TASK_HANDLER void handler(void)
+    static LV_ATTRIBUTE_TASK_HANDLER void handler(void);
+
+    /**
+     * @brief 运行到期的任务,返回可以休眠的时间
+     * 计入 LVTask,有动画时的动画任务,有无效区域时的刷新任务,
+     * 以及输入设备的读取任务(setWakeOnInput(true) 时不计入).
+     * 主循环可以休眠返回的时间,或者直到 wake() 被调用.
+     * @return 距离下一个任务到期的毫秒数,没有任务时返回 LV_TASK_NO_DEADLINE
+     */
+    static uint32_t handlerTickless(void);
+
+    /**
+     * @brief 记录LVGL的动画任务,handlerTickless() 据此只在有动画时等待它
+     * 在 lv_init() 之后,注册显示/输入设备和创建其他任务之前调用一次.
+     * 没有调用时动画任务按自己的周期等待.
+     */
+    static void initTickless(void);
+
+    /**
+     * @brief 设置唤醒主循环的函数
+     * 比如释放主循环等待的信号量,或者发送任务通知
+     * @param wake_cb
+     */
+    static void setWakeCallBack(const LVTaskWakeCallBack & wake_cb) { s_wakeCallBack = wake_cb; }
+
+    /**
+     * @brief 提前唤醒主循环
+     * 任务开始/停止时自动调用,输入设备的中断中也应该调用
+     */
+    static void wake(void)
     {
-        lv_task_handler();
+        if(s_wakeCallBack)
+            s_wakeCallBack();
     }
 
+    /**
+     * @brief 输入设备是否通过 wake() 唤醒
+     * 为true时 handlerTickless() 不等待输入设备的读取任务
+     * @param en
+     */
+    static void setWakeOnInput(bool en) { s_wakeOnInput = en; }
+    static bool isWakeOnInput(void) { return s_wakeOnInput; }
+
     /**
      * Create an "empty" task. It needs to initialzed with at least
      * `lv_task_set_cb` and `lv_task_set_period`
@@ -120,6 +191,10 @@ public:
         LVMemory::unsetNewTaskAddr();
         m_callBack = task_cb;
         m_priority = prio;
+#if LV_USE_TASK_PROFILE
+        if(LVTaskProfile::isAutoEnable())
+            setProfileEnabled(true);
+#endif
 
         lvInfo("LVTask(0x%p) Created. ",this);
     }
@@ -131,6 +206,12 @@ public:
 
     virtual ~LVTask()
     {
+#if LV_USE_TASK_SCHEDULER
+        LVTaskScheduler::remove(this);
+#endif
+#if LV_USE_TASK_PROFILE
+        delete m_profile;
+#endif
         if(!class_ptr.deleted)
         {
             class_ptr.deleted = true;
@@ -174,7 +255,7 @@ public:
             m_priority = prio;
             if(isRunning())
             {
-                lv_task_set_prio(this, prio);
+                activate(prio);
             }
         }
     }
@@ -187,6 +268,9 @@ public:
     void setPeriod(uint32_t period)
     {
         lv_task_set_period(this,period);
+#if LV_USE_TASK_SCHEDULER
+        LVTaskScheduler::update(this);
+#endif
     }
 
     /**
@@ -196,6 +280,9 @@ public:
     void readyToRun()
     {
         lv_task_ready(this);
+#if LV_USE_TASK_SCHEDULER
+        LVTaskScheduler::update(this);
+#endif
     }
 
     /**
@@ -204,7 +291,13 @@ public:
      */
     void once()
     {
+#if LV_USE_TASK_SCHEDULER
+        //调度器不经过 lv_task_handler,用次数限制实现
+        setTimes(m_count + 1);
+        setDeleteAfterStop(true);
+#else
         lv_task_once(this);
+#endif
     }
 
     /**
@@ -215,6 +308,9 @@ public:
     void reset()
     {
         lv_task_reset(this);
+#if LV_USE_TASK_SCHEDULER
+        LVTaskScheduler::update(this);
+#endif
     }
 
     /**
@@ -224,10 +320,14 @@ public:
     static void setWholeTaskEnable(bool en)
     {
         lv_task_enable(en);
+#if LV_USE_TASK_SCHEDULER
+        LVTaskScheduler::setEnabled(en);
+#endif
     }
 
     /**
      * Get idle percentage
+     * NOTE: 开启 LV_USE_TASK_SCHEDULER 后 LVTask 的运行时间不计入
      * @return the lv_task idle in percentage
      */
     static uint8_t getIdlePercentage(void)
@@ -263,7 +363,7 @@ public:
      */
     void start()
     {
-        lv_task_set_prio(this, m_priority);
+        activate(m_priority);
         reset();
     }
 
@@ -274,7 +374,7 @@ public:
     void start(Priority prio)
     {
         setPriority(prio);
-        lv_task_set_prio(this, m_priority);
+        activate(m_priority);
         reset();
     }
 
@@ -306,7 +406,7 @@ public:
      */
     void stop()
     {
-        lv_task_set_prio(this, LV_TASK_PRIO_OFF);
+        activate(PRIO_OFF);
         resetCount();
 
         if(isDeleteAfterStop())
@@ -329,7 +429,11 @@ public:
 
     bool isRunning()
     {
+#if LV_USE_TASK_SCHEDULER
+        return m_schedIndex >= 0;
+#else
         return  this->prio != LV_TASK_PRIO_OFF;
+#endif
     }
 
     /**
@@ -394,6 +498,34 @@ public:
         onceTask->start(period,1);
     }
 
+#if LV_USE_TASK_PROFILE
+    /**
+     * @brief 开启或关闭运行统计
+     * @param en
+     */
+    void setProfileEnabled(bool en)
+    {
+        if(en && m_profile == nullptr)
+        {
+            //统计随任务存在,不能放在屏幕内存区中
+            LVMemoryArena * arena = LVMemoryArena::suspend();
+            m_profile = new LVTaskProfile(this);
+            LVMemoryArena::resume(arena);
+        }
+        else if(!en && m_profile != nullptr)
+        {
+            delete m_profile;
+            m_profile = nullptr;
+        }
+    }
+
+    /**
+     * @brief 运行统计
+     * @return 未开启时返回nullptr
+     */
+    LVTaskProfile * profile() { return m_profile; }
+#endif
+
     /**
      * @brief 当前任务的函数
      * @return
@@ -419,6 +551,16 @@ public:
             {
                 //统计任务运行次数
                 ++m_count;
+#if LV_USE_TASK_PROFILE
+                if(m_profile)
+                {
+                    uint32_t start = m_profile->begin();
+                    run();
+                    if(m_profile)
+                        m_profile->end(start);
+                }
+                else
+#endif
                 run();
 
                 if(!getSurplusTimes())
@@ -449,6 +591,35 @@ public:
 
 protected:
 
+    /**
+     * @brief 按优先级运行或停止任务
+     * @param prio PRIO_OFF 表示停止
+     */
+    void activate(lv_task_prio_t prio)
+    {
+#if LV_USE_TASK_SCHEDULER
+        //任务在LVGL中保持停止,只由调度器运行
+        if(prio == PRIO_OFF)
+            LVTaskScheduler::remove(this);
+        else
+            LVTaskScheduler::add(this);
+#else
+        lv_task_set_prio(this, prio);
+#endif
+        //主循环可能正在按之前的任务休眠
+        wake();
+    }
+
+    /**
+     * @brief LVGL任务列表中最早到期的时间
+     * @return
+     */
+    static uint32_t lvglDeadline(void);
+
+    static LVTaskWakeCallBack s_wakeCallBack; //!< 唤醒主循环的函数
+    static bool s_wakeOnInput;                //!< 输入设备通过 wake() 唤醒
+    static lv_task_t * s_animTask;            //!< LVGL的动画任务
+
     /**
      * @brief 具体的任务函数,需要子类去实现
      * 一定注意,函数内不能存在阻塞
@@ -0,0 +1,121 @@
+#include "LVTaskProfile.h"
+#include "LVTask.h"
+#include <string.h>
+
+#if LV_USE_TASK_PROFILE
+
+LVTaskProfile * LVTaskProfile::s_first = nullptr;
+LVTaskOverrunCallBack LVTaskProfile::s_overrunCallBack;
+bool LVTaskProfile::s_autoEnable = false;
+
+LVTaskProfile::LVTaskProfile(LVTask *task)
+    : m_task(task)
+    , m_budget(LV_TASK_PROFILE_BUDGET)
+{
+    m_next = s_first;
+    if(s_first)
+        s_first->m_prev = this;
+    s_first = this;
+}
+
+LVTaskProfile::~LVTaskProfile()
+{
+    if(m_prev)
+        m_prev->m_next = m_next;
+    else
+        s_first = m_next;
+    if(m_next)
+        m_next->m_prev = m_prev;
+}
+
+uint32_t LVTaskProfile::begin()
+{
+    uint32_t now = lv_tick_get();
+    uint32_t period = m_task->period;
+    //两次开始的间隔达到 n 个周期,中间错过了 n - 1 次运行
+    uint32_t gap = now - m_lastStart;
+    if(m_runCount && period && gap >= 2 * period)
+        m_missCount += gap / period - 1;
+    m_lastStart = now;
+    return LV_TASK_PROFILE_TIME();
+}
+
+void LVTaskProfile::end(uint32_t start)
+{
+    uint32_t elapsed = LV_TASK_PROFILE_TIME() - start;
+    m_lastTime = elapsed;
+    m_totalTime += elapsed;
+    ++m_runCount;
+    if(elapsed > m_maxTime)
+        m_maxTime = elapsed;
+
+    uint8_t bucket = 0;
+    while (bucket + 1 < HISTOGRAM_SIZE && elapsed >= (128u << bucket))
+        ++bucket;
+    if(m_histogram[bucket] != UINT16_MAX)
+        ++m_histogram[bucket];
+
+    if(m_budget && elapsed > m_budget)
+    {
+        ++m_overrunCount;
+        if(s_overrunCallBack)
+            s_overrunCallBack(m_task,elapsed);
+    }
+}
+
+void LVTaskProfile::reset()
+{
+    m_lastTime = 0;
+    m_maxTime = 0;
+    m_totalTime = 0;
+    m_runCount = 0;
+    m_missCount = 0;
+    m_overrunCount = 0;
+    memset(m_histogram,0,sizeof(m_histogram));
+}
+
+uint8_t LVTaskProfile::top(LVTaskProfile **profiles, uint8_t count)
+{
+    uint8_t n = 0;
+    for (LVTaskProfile * p = s_first; p; p = p->m_next)
+    {
+        if(p->m_runCount == 0)
+            continue;
+
+        //插入排序,保留前count个
+        uint8_t i = n < count ? n++ : count;
+        while (i > 0 && profiles[i - 1]->m_maxTime < p->m_maxTime)
+        {
+            if(i < count)
+                profiles[i] = profiles[i - 1];
+            --i;
+        }
+        if(i < count)
+            profiles[i] = p;
+    }
+    return n;
+}
+
+void LVTaskProfile::dump(uint8_t count)
+{
+    LVTaskProfile * profiles[32];
+    if(count > 32)
+        count = 32;
+    uint8_t n = top(profiles,count);
+    lvInfo("LVTaskProfile top %d tasks (us):",n);
+    for (uint8_t i = 0; i < n; ++i)
+    {
+        LVTaskProfile * p = profiles[i];
+        lvInfo("  LVTask(0x%p) period:%d runs:%d last:%d avg:%d max:%d miss:%d overrun:%d",
+               p->m_task,p->m_task->period,p->m_runCount,p->m_lastTime,p->averageTime(),
+               p->m_maxTime,p->m_missCount,p->m_overrunCount);
+    }
+}
+
+void LVTaskProfile::resetAll()
+{
+    for (LVTaskProfile * p = s_first; p; p = p->m_next)
+        p->reset();
+}
+
+#endif // LV_USE_TASK_PROFILE
@@ -0,0 +1,175 @@
+/**
+ * @file LVTaskProfile.h
+ *
+ */
+
+#ifndef LVTASKPROFILE_H
+#define LVTASKPROFILE_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+#include "LVMemory.h"
+#include "../LVCore/LVCallBack.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 微秒计时,默认使用ESP-IDF的高精度定时器,其他平台退化为LVGL毫秒时钟
+ */
+#ifndef LV_TASK_PROFILE_TIME
+#ifdef ESP_PLATFORM
+#include <esp_timer.h>
+#define LV_TASK_PROFILE_TIME() ((uint32_t)esp_timer_get_time())
+#else
+#include <lv_hal/lv_hal_tick.h>
+#define LV_TASK_PROFILE_TIME() (lv_tick_get() * 1000u)
+#endif
+#endif
+
+/**
+ * 默认的单次运行时间预算(微秒),超出时调用超时回调
+ */
+#ifndef LV_TASK_PROFILE_BUDGET
+#define LV_TASK_PROFILE_BUDGET 10000
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+class LVTask;
+
+/**
+ * 任务运行超时的回调,参数为任务和本次运行的微秒数
+ */
+using LVTaskOverrunCallBack = LVCallBack<void(LVTask*,uint32_t),void>;
+
+/**
+ * @brief 单个任务的运行统计
+ * 由 LVTask::setProfileEnabled() 创建,随任务一起删除.
+ * 记录每次运行的耗时(最近,平均,最大,分布),
+ * 错过的周期(两次开始的间隔达到 n 个周期时记 n - 1 次),
+ * 以及超过时间预算的次数.
+ *
+ * 需要开启 LV_USE_TASK_PROFILE
+ * NOTE: 非线程安全,只能在GUI线程中使用
+ */
+class LVTaskProfile
+{
+    LV_MEMORY
+
+    friend class LVTask;
+public:
+    /**
+     * @brief 耗时分布的分级数量
+     * [0,128us) [128us,256us) ... [8ms,16ms) [16ms,...)
+     */
+    static constexpr uint8_t HISTOGRAM_SIZE = 9;
+
+protected:
+    LVTask * m_task;                 //!< 所属的任务
+    uint32_t m_lastTime = 0;         //!< 最近一次运行的微秒数
+    uint32_t m_maxTime = 0;          //!< 最长一次运行的微秒数
+    uint64_t m_totalTime = 0;        //!< 累计运行的微秒数
+    uint32_t m_runCount = 0;         //!< 运行次数
+    uint32_t m_missCount = 0;        //!< 错过周期的次数
+    uint32_t m_overrunCount = 0;     //!< 超过预算的次数
+    uint32_t m_budget;               //!< 单次运行的时间预算(微秒),0表示不检查
+    uint32_t m_lastStart = 0;        //!< 上一次开始运行的时钟(毫秒)
+    uint16_t m_histogram[HISTOGRAM_SIZE] = {0};
+    LVTaskProfile * m_prev = nullptr;
+    LVTaskProfile * m_next = nullptr;
+
+    static LVTaskProfile * s_first;
+    static LVTaskOverrunCallBack s_overrunCallBack;
+    static bool s_autoEnable;
+
+    LVTaskProfile(LVTask * task);
+    ~LVTaskProfile();
+
+    /**
+     * @brief 任务开始运行
+     * @return 开始的微秒时间
+     */
+    uint32_t begin();
+
+    /**
+     * @brief 任务运行结束
+     * @param start begin() 的返回值
+     */
+    void end(uint32_t start);
+
+public:
+    LVTask * task() const { return m_task; }
+    uint32_t lastTime() const { return m_lastTime; }
+    uint32_t maxTime() const { return m_maxTime; }
+    uint32_t averageTime() const { return m_runCount ? (uint32_t)(m_totalTime / m_runCount) : 0; }
+    uint64_t totalTime() const { return m_totalTime; }
+    uint32_t runCount() const { return m_runCount; }
+    uint32_t missCount() const { return m_missCount; }
+    uint32_t overrunCount() const { return m_overrunCount; }
+    uint32_t histogram(uint8_t bucket) const { return bucket < HISTOGRAM_SIZE ? m_histogram[bucket] : 0; }
+
+    uint32_t budget() const { return m_budget; }
+    void setBudget(uint32_t us) { m_budget = us; }
+
+    /**
+     * @brief 清除统计
+     */
+    void reset();
+
+    LVTaskProfile * next() const { return m_next; }
+
+    /**
+     * @brief 所有统计中的任务
+     * @return
+     */
+    static LVTaskProfile * first() { return s_first; }
+
+    /**
+     * @brief 设置任务运行超过预算时的回调
+     * @param overrun_cb
+     */
+    static void setOverrunCallBack(const LVTaskOverrunCallBack & overrun_cb) { s_overrunCallBack = overrun_cb; }
+
+    /**
+     * @brief 新建的任务是否自动开启统计
+     * @param en
+     */
+    static void setAutoEnable(bool en) { s_autoEnable = en; }
+    static bool isAutoEnable() { return s_autoEnable; }
+
+    /**
+     * @brief 最长运行时间最大的任务
+     * @param profiles 输出的数组
+     * @param count 数组大小
+     * @return 实际输出的数量
+     */
+    static uint8_t top(LVTaskProfile ** profiles,uint8_t count);
+
+    /**
+     * @brief 通过 LVLog 输出最耗时的任务
+     * @param count
+     */
+    static void dump(uint8_t count = 10);
+
+    /**
+     * @brief 清除所有任务的统计
+     */
+    static void resetAll();
+
+private:
+    LVTaskProfile(const LVTaskProfile&) = delete;
+    LVTaskProfile& operator = (const LVTaskProfile&) = delete;
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif // LVTASKPROFILE_H
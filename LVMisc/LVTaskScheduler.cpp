@@ -0,0 +1,175 @@
+#include "LVTaskScheduler.h"
+#include "LVTask.h"
+#include "LVMemoryArena.h"
+#include <lv_hal/lv_hal_tick.h>
+
+#if LV_USE_TASK_SCHEDULER
+
+bool LVTaskScheduler::s_enabled = true;
+bool LVTaskScheduler::s_running = false;
+
+LVTaskScheduler::Heap &LVTaskScheduler::heap(uint8_t prio)
+{
+    //PRIO_LOWEST ~ PRIO_HIGHEST 各一个堆
+    static Heap s_heaps[LVTask::PRIO_HIGHEST];
+    return s_heaps[prio - LVTask::PRIO_LOWEST];
+}
+
+uint32_t LVTaskScheduler::dueTime(const LVTask *task)
+{
+    return task->last_run + (task->period ? task->period : 1);
+}
+
+bool LVTaskScheduler::before(const LVTask *a, const LVTask *b)
+{
+    //按时钟差值比较,时钟溢出后仍然正确
+    return (int32_t)(dueTime(a) - dueTime(b)) < 0;
+}
+
+void LVTaskScheduler::place(Heap &heap, uint32_t pos, LVTask *task)
+{
+    heap[pos] = task;
+    task->m_schedIndex = pos;
+}
+
+void LVTaskScheduler::siftUp(Heap &heap, uint32_t pos)
+{
+    LVTask * task = heap[pos];
+    while (pos > 0)
+    {
+        uint32_t parent = (pos - 1) >> 1;
+        if(!before(task,heap[parent]))
+            break;
+        place(heap,pos,heap[parent]);
+        pos = parent;
+    }
+    place(heap,pos,task);
+}
+
+void LVTaskScheduler::siftDown(Heap &heap, uint32_t pos)
+{
+    LVTask * task = heap[pos];
+    uint32_t size = heap.size();
+    while (true)
+    {
+        uint32_t child = pos * 2 + 1;
+        if(child >= size)
+            break;
+        if(child + 1 < size && before(heap[child + 1],heap[child]))
+            ++child;
+        if(!before(heap[child],task))
+            break;
+        place(heap,pos,heap[child]);
+        pos = child;
+    }
+    place(heap,pos,task);
+}
+
+void LVTaskScheduler::add(LVTask *task)
+{
+    if(task->m_schedIndex >= 0)
+        remove(task);
+    if(task->m_priority == LVTask::PRIO_OFF)
+        return;
+
+    task->m_schedPrio = task->m_priority;
+    Heap & h = heap(task->m_schedPrio);
+    //调度表的生命周期比屏幕长,不能放在屏幕内存区中
+    LVMemoryArena * arena = LVMemoryArena::suspend();
+    h.push_back(task);
+    LVMemoryArena::resume(arena);
+    siftUp(h,h.size() - 1);
+}
+
+void LVTaskScheduler::remove(LVTask *task)
+{
+    if(task->m_schedIndex < 0)
+        return;
+
+    Heap & h = heap(task->m_schedPrio);
+    uint32_t pos = task->m_schedIndex;
+    task->m_schedIndex = -1;
+
+    LVTask * last = h.back();
+    h.pop_back();
+    if(last != task)
+    {
+        place(h,pos,last);
+        update(last);
+    }
+}
+
+void LVTaskScheduler::update(LVTask *task)
+{
+    if(task->m_schedIndex < 0)
+        return;
+
+    Heap & h = heap(task->m_schedPrio);
+    uint32_t pos = task->m_schedIndex;
+    if(pos > 0 && before(task,h[(pos - 1) >> 1]))
+        siftUp(h,pos);
+    else
+        siftDown(h,pos);
+}
+
+LVTask *LVTaskScheduler::nextDue(uint32_t now)
+{
+    for (uint8_t prio = LVTask::PRIO_HIGHEST; prio >= LVTask::PRIO_LOWEST; --prio)
+    {
+        Heap & h = heap(prio);
+        if(!h.empty() && (int32_t)(now - dueTime(h.front())) >= 0)
+            return h.front();
+    }
+    return nullptr;
+}
+
+uint32_t LVTaskScheduler::handler()
+{
+    if(!s_enabled || s_running)
+        return nextDeadline();
+
+    s_running = true;
+    uint32_t now = lv_tick_get();
+    LVTask * task;
+    while ((task = nextDue(now)) != nullptr)
+    {
+        //先排到下一个周期,任务中可以安全地停止,删除或重新开始自己
+        task->last_run = now;
+        update(task);
+        task->checkAndRun();
+    }
+    s_running = false;
+
+    return nextDeadline();
+}
+
+uint32_t LVTaskScheduler::nextDeadline()
+{
+    if(!s_enabled)
+        return LV_TASK_NO_DEADLINE;
+
+    uint32_t now = lv_tick_get();
+    uint32_t deadline = LV_TASK_NO_DEADLINE;
+    for (uint8_t prio = LVTask::PRIO_LOWEST; prio <= LVTask::PRIO_HIGHEST; ++prio)
+    {
+        Heap & h = heap(prio);
+        if(h.empty())
+            continue;
+        int32_t remain = (int32_t)(dueTime(h.front()) - now);
+        if(remain <= 0)
+            return 0;
+        if((uint32_t)remain < deadline)
+            deadline = remain;
+    }
+    return deadline;
+}
+
+uint32_t LVTaskScheduler::count()
+{
+    uint32_t n = 0;
+    for (uint8_t prio = LVTask::PRIO_LOWEST; prio <= LVTask::PRIO_HIGHEST; ++prio)
+        n += heap(prio).size();
+    return n;
+}
+
+#endif // LV_USE_TASK_SCHEDULER
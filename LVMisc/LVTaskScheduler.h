@@ -0,0 +1,108 @@
+/**
+ * @file LVTaskScheduler.h
+ *
+ */
+
+#ifndef LVTASKSCHEDULER_H
+#define LVTASKSCHEDULER_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+#include "lvvector.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * 没有等待运行的任务时 nextDeadline() 的返回值
+ */
+#define LV_TASK_NO_DEADLINE UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+class LVTask;
+
+/**
+ * @brief LVTask 的调度器
+ * 每个优先级一个按到期时间排序的最小堆,
+ * 空闲时只需要查看各个堆顶,运行时的开销与到期任务的数量成正比,
+ * 而不是像 lv_task_handler() 一样遍历所有任务.
+ *
+ * 与LVGL相同,每运行一个任务后都从最高优先级重新查找到期的任务.
+ * 周期为0的任务每毫秒最多运行一次.
+ *
+ * 只调度 LVTask,LVGL内部的任务(刷新,输入设备,动画)仍由 lv_task_handler() 运行.
+ * 需要开启 LV_USE_TASK_SCHEDULER
+ *
+ * NOTE: 非线程安全,只能在GUI线程中使用
+ */
+class LVTaskScheduler
+{
+    LVTaskScheduler() = delete;
+    ~LVTaskScheduler() = delete;
+public:
+    /**
+     * @brief 加入调度,已在调度中时按当前优先级重新排列
+     * @param task
+     */
+    static void add(LVTask * task);
+
+    /**
+     * @brief 移出调度
+     * @param task
+     */
+    static void remove(LVTask * task);
+
+    /**
+     * @brief 任务的到期时间改变后(周期,上次运行时间)重新排列
+     * @param task
+     */
+    static void update(LVTask * task);
+
+    /**
+     * @brief 运行所有到期的任务
+     * @return 距离下一个任务到期的毫秒数,没有任务时返回 LV_TASK_NO_DEADLINE
+     */
+    static uint32_t handler();
+
+    /**
+     * @brief 距离下一个任务到期的毫秒数
+     * @return 已经到期返回0,没有任务时返回 LV_TASK_NO_DEADLINE
+     */
+    static uint32_t nextDeadline();
+
+    /**
+     * @brief 调度中的任务数量
+     * @return
+     */
+    static uint32_t count();
+
+    static void setEnabled(bool en) { s_enabled = en; }
+    static bool isEnabled() { return s_enabled; }
+
+protected:
+    typedef LVVector<LVTask*> Heap;
+
+    static Heap & heap(uint8_t prio);
+    static uint32_t dueTime(const LVTask * task);
+    static bool before(const LVTask * a,const LVTask * b);
+    static void siftUp(Heap & heap,uint32_t pos);
+    static void siftDown(Heap & heap,uint32_t pos);
+    static void place(Heap & heap,uint32_t pos,LVTask * task);
+    static LVTask * nextDue(uint32_t now);
+
+    static bool s_enabled;
+    static bool s_running; //!< 防止在任务中重入
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif // LVTASKSCHEDULER_H
@@ -2,21 +2,25 @@
 #define LVVECTOR_H
 
 #include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
 #include "LVMemory.h"
 #include "LVMisc/LVLog.h"
 
-//TODO:实现向量表的功能
-//erase()
-//emplace
-//emplace_back
-//swap
-//emplace_back
-
+/**
+ * @brief 连续存储的向量表
+ * 内存经 LVMemory 分配(受屏幕内存区和内存跟踪管理),
+ * 只为已有的元素构造对象,扩容时移动而不是复制元素,
+ * 可平凡复制的类型直接用 LVMemory::reallocate 扩容.
+ */
 template<class T>
 class LVVector {
     LV_MEMORY
 
-    void abort(const char * mesg = "");
+    void abort(const char * mesg = "") const;
 
 public:
     typedef size_t size_type;
@@ -26,16 +30,27 @@ public:
 
 private:
     size_type size_ = 0;
-    size_type capacity_ = 0; // 2^n
+    size_type capacity_ = 0; // 2^n , shrink_to_fit() 之后等于 size_
     value_type* buffer_ = nullptr;
 
+    typedef std::integral_constant<bool,std::is_trivially_copyable<T>::value> trivial_type;
+
+    void reallocate(size_type n);
+    void reallocate(size_type n, std::true_type);
+    void reallocate(size_type n, std::false_type);
+    void grow(size_type n);
+    void destroy(iterator first, iterator last);
+
 public:
     LVVector();
     LVVector(size_type n, const value_type& val = value_type());
+    LVVector(std::initializer_list<value_type> list);
     LVVector(const LVVector& x);
+    LVVector(LVVector&& x);
     ~LVVector();
 
     void reserve(size_type n);
+    void shrink_to_fit();
     size_type capacity() const;
     size_type size() const;
     bool empty() const;
@@ -48,6 +63,7 @@ public:
     value_type& operator [] (size_type n);
     const value_type& operator [] (size_type n) const;
     LVVector& operator = (const LVVector& x);
+    LVVector& operator = (LVVector&& x);
 
     void clear();
     value_type& back();
@@ -56,9 +72,22 @@ public:
     const value_type& front() const;
 
     void push_back(const value_type& val);
+    void push_back(value_type&& val);
+    template<class... Args>
+    value_type& emplace_back(Args&&... args);
     void pop_back();
 
-    void resize(size_type n, value_type val = value_type());
+    iterator insert(const_iterator pos, const value_type& val);
+    iterator insert(const_iterator pos, value_type&& val);
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+
+    void swap(LVVector& x);
+
+    void resize(size_type n);
+    void resize(size_type n, const value_type& val);
 
     iterator begin();
     const_iterator begin() const;
@@ -69,12 +98,74 @@ public:
 
 
 template<class T>
-void LVVector<T>::abort(const char * mesg)
+void LVVector<T>::abort(const char * mesg) const
 {
     lvError("LVVector(%p) - %s",this,mesg);
     while (1) {}
 }
 
+template<class T> inline
+void LVVector<T>::reallocate(size_type n)
+{
+    reallocate(n,trivial_type());
+}
+
+template<class T> inline
+void LVVector<T>::reallocate(size_type n, std::true_type)
+{
+    //可平凡复制的元素直接按字节搬移,内存区中的最后一次分配还能原地扩展
+    if (n == 0) {
+        LVMemory::free(buffer_);
+        buffer_ = nullptr;
+    } else {
+        T* tmp = static_cast<T*>(LVMemory::reallocate(buffer_,n * sizeof(T)));
+        if (tmp == nullptr)
+            abort("LVVector<T>::reallocate out of memory");
+        buffer_ = tmp;
+    }
+    capacity_ = n;
+}
+
+template<class T> inline
+void LVVector<T>::reallocate(size_type n, std::false_type)
+{
+    T* tmp = nullptr;
+    if (n) {
+        tmp = static_cast<T*>(LVMemory::allocate(n * sizeof(T)));
+        if (tmp == nullptr)
+            abort("LVVector<T>::reallocate out of memory");
+        for (size_t i = 0; i < size_; ++i) {
+            ::new (static_cast<void*>(tmp + i)) T(std::move(buffer_[i]));
+            buffer_[i].~T();
+        }
+    }
+    LVMemory::free(buffer_);
+    buffer_ = tmp;
+    capacity_ = n;
+}
+
+template<class T> inline
+void LVVector<T>::grow(size_type n)
+{
+    size_type cap = 1;
+    if (cap < n) {
+        cap = 2;
+        while (cap < n) {
+            cap *= 2;
+        }
+    }
+    reallocate(cap);
+}
+
+template<class T> inline
+void LVVector<T>::destroy(iterator first, iterator last)
+{
+    if (!std::is_trivially_destructible<T>::value) {
+        for (; first != last; ++first)
+            first->~T();
+    }
+}
+
 template<class T> inline
 LVVector<T>::LVVector() : size_(0), capacity_(0), buffer_(nullptr)
 {
@@ -83,45 +174,54 @@ LVVector<T>::LVVector() : size_(0), capacity_(0), buffer_(nullptr)
 template<class T> inline
 LVVector<T>::LVVector(size_type n, const value_type& val)
 {
-    reserve(n);
+    resize(n,val);
+}
 
-    size_ = n;
-    for (size_t i = 0; i < n; ++i)
-        buffer_[i] = val;
+template<class T> inline
+LVVector<T>::LVVector(std::initializer_list<value_type> list)
+{
+    reserve(list.size());
+    for (const value_type & val : list)
+        ::new (static_cast<void*>(buffer_ + size_++)) T(val);
 }
 
 template<class T> inline
 LVVector<T>::LVVector(const LVVector& x)
 {
     reserve(x.size_);
-
-    size_ = x.size_;
     for (size_t i = 0; i < x.size_; ++i)
-        buffer_[i] = x.buffer_[i];
+        ::new (static_cast<void*>(buffer_ + i)) T(x.buffer_[i]);
+    size_ = x.size_;
+}
+
+template<class T> inline
+LVVector<T>::LVVector(LVVector&& x)
+    : size_(x.size_), capacity_(x.capacity_), buffer_(x.buffer_)
+{
+    x.size_ = 0;
+    x.capacity_ = 0;
+    x.buffer_ = nullptr;
 }
 
 template<class T> inline
 LVVector<T>::~LVVector()
 {
-    if (buffer_)
-        delete [] buffer_;
+    destroy(begin(),end());
+    LVMemory::free(buffer_);
 }
 
 template<class T> inline
 void LVVector<T>::reserve(size_type n)
 {
-    if (capacity_ < n) {
-        delete [] buffer_;
+    if (capacity_ < n)
+        grow(n);
+}
 
-        capacity_ = 1;
-        if (capacity_ < n) {
-            capacity_ = 2;
-            while (capacity_ < n) {
-                capacity_ *= 2;
-            }
-        }
-        buffer_ = new value_type[capacity_];
-    }
+template<class T> inline
+void LVVector<T>::shrink_to_fit()
+{
+    if (capacity_ > size_)
+        reallocate(size_);
 }
 
 template<class T> inline
@@ -188,18 +288,30 @@ const T& LVVector<T>::operator [] (size_type n) const
 template<class T> inline
 LVVector<T>& LVVector<T>::operator = (const LVVector& x)
 {
-    reserve(x.size_);
-
-    size_ = x.size_;
-    for (size_t i = 0; i < size_; ++i)
-        buffer_[i] = x.buffer_[i];
+    if (this != &x) {
+        clear();
+        reserve(x.size_);
+        for (size_t i = 0; i < x.size_; ++i)
+            ::new (static_cast<void*>(buffer_ + i)) T(x.buffer_[i]);
+        size_ = x.size_;
+    }
+    return *this;
+}
 
+template<class T> inline
+LVVector<T>& LVVector<T>::operator = (LVVector&& x)
+{
+    if (this != &x) {
+        LVVector tmp(std::move(x));
+        swap(tmp);
+    }
     return *this;
 }
 
 template<class T> inline
 void LVVector<T>::clear()
 {
+    destroy(begin(),end());
     size_ = 0;
 }
 
@@ -238,21 +350,28 @@ const T& LVVector<T>::front() const
 template<class T> inline
 void LVVector<T>::push_back(const value_type& val)
 {
-    if (size_ >= capacity_) {
-        T* tmp = new T[size_];
-        for (size_t i = 0; i < size_; ++i)
-            tmp[i] = buffer_[i];
-
-        reserve(size_+1);
+    emplace_back(val);
+}
 
-        for (size_t i = 0; i < size_; ++i)
-            buffer_[i] = tmp[i];
+template<class T> inline
+void LVVector<T>::push_back(value_type&& val)
+{
+    emplace_back(std::move(val));
+}
 
-        delete [] tmp;
+template<class T>
+template<class... Args> inline
+T& LVVector<T>::emplace_back(Args&&... args)
+{
+    if (size_ >= capacity_) {
+        //参数可能引用自身的元素,扩容前先构造
+        T tmp(std::forward<Args>(args)...);
+        grow(size_ + 1);
+        ::new (static_cast<void*>(buffer_ + size_)) T(std::move(tmp));
+    } else {
+        ::new (static_cast<void*>(buffer_ + size_)) T(std::forward<Args>(args)...);
     }
-
-    buffer_[size_] = val;
-    size_ += 1;
+    return buffer_[size_++];
 }
 
 template<class T> inline
@@ -261,27 +380,104 @@ void LVVector<T>::pop_back()
     if (size_ == 0)
         abort("LVVector<T>::pop_back() empty vector");
     --size_;
+    buffer_[size_].~T();
 }
 
 template<class T> inline
-void LVVector<T>::resize(size_type n, value_type val)
+T* LVVector<T>::insert(const_iterator pos, const value_type& val)
 {
-    if (size_ < n) {
-        if (n > capacity_) {
-            T* tmp = new T[size_];
-            for (size_t i = 0; i < size_; ++i)
-                tmp[i] = buffer_[i];
+    return emplace(pos,val);
+}
 
-            reserve(n);
+template<class T> inline
+T* LVVector<T>::insert(const_iterator pos, value_type&& val)
+{
+    return emplace(pos,std::move(val));
+}
+
+template<class T>
+template<class... Args> inline
+T* LVVector<T>::emplace(const_iterator pos, Args&&... args)
+{
+    size_type n = pos - buffer_;
+    if (size_ < n)
+        abort("LVVector<T>::emplace position out-of-bounds");
+    if (n == size_) {
+        emplace_back(std::forward<Args>(args)...);
+        return buffer_ + n;
+    }
 
-            for (size_t i = 0; i < size_; ++i)
-                buffer_[i] = tmp[i];
+    T tmp(std::forward<Args>(args)...);
+    reserve(size_ + 1);
+    //最后一个元素移动到未构造的位置,其余向后移动一位
+    ::new (static_cast<void*>(buffer_ + size_)) T(std::move(buffer_[size_ - 1]));
+    for (size_t i = size_ - 1; i > n; --i)
+        buffer_[i] = std::move(buffer_[i - 1]);
+    buffer_[n] = std::move(tmp);
+    ++size_;
+    return buffer_ + n;
+}
 
-            delete [] tmp;
-        }
+template<class T> inline
+T* LVVector<T>::erase(const_iterator pos)
+{
+    return erase(pos,pos + 1);
+}
 
+template<class T> inline
+T* LVVector<T>::erase(const_iterator first, const_iterator last)
+{
+    size_type n = first - buffer_;
+    size_type count = last - first;
+    if (last < first || size_ < n + count)
+        abort("LVVector<T>::erase range out-of-bounds");
+    if (count) {
+        for (size_t i = n; i + count < size_; ++i)
+            buffer_[i] = std::move(buffer_[i + count]);
+        destroy(end() - count,end());
+        size_ -= count;
+    }
+    return buffer_ + n;
+}
+
+template<class T> inline
+void LVVector<T>::swap(LVVector& x)
+{
+    std::swap(size_,x.size_);
+    std::swap(capacity_,x.capacity_);
+    std::swap(buffer_,x.buffer_);
+}
+
+template<class T> inline
+void LVVector<T>::resize(size_type n)
+{
+    if (size_ < n) {
+        reserve(n);
         for (size_t i = size_; i < n; ++i)
-            buffer_[i] = val;
+            ::new (static_cast<void*>(buffer_ + i)) T();
+    } else {
+        destroy(buffer_ + n,end());
+    }
+
+    size_ = n;
+}
+
+template<class T> inline
+void LVVector<T>::resize(size_type n, const value_type& val)
+{
+    if (size_ < n) {
+        if (n > capacity_) {
+            //val 可能引用自身的元素
+            T tmp(val);
+            grow(n);
+            for (size_t i = size_; i < n; ++i)
+                ::new (static_cast<void*>(buffer_ + i)) T(tmp);
+        } else {
+            for (size_t i = size_; i < n; ++i)
+                ::new (static_cast<void*>(buffer_ + i)) T(val);
+        }
+    } else {
+        destroy(buffer_ + n,end());
     }
 
     size_ = n;
@@ -311,6 +507,12 @@ const T* LVVector<T>::end() const
     return buffer_ + size_;
 }
 
+template<class T> static inline
+void swap(LVVector<T>& lhs, LVVector<T>& rhs)
+{
+    lhs.swap(rhs);
+}
+
 template<class T> static inline
 bool operator == (const LVVector<T>& lhs, const LVVector<T>& rhs)
 {
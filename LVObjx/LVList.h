@@ -16,14 +16,33 @@
 #include "../LVCore/LVObject.h"
 #include "LVButton.h"
 #include "LVPage.h"
+#include "../LVMisc/lvvector.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*虚拟列表在可见行之外上下各多保留的行数*/
+#ifndef LV_LIST_VIRTUAL_OVERSCAN
+#define LV_LIST_VIRTUAL_OVERSCAN 2
+#endif
+
+/*虚拟列表滚动区域的最大高度(像素),行数多时滚动区域只覆盖其中一段*/
+#ifndef LV_LIST_VIRTUAL_WINDOW
+#define LV_LIST_VIRTUAL_WINDOW (LV_COORD_MAX / 2)
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+class LVList;
+
+/**
+ * @brief 虚拟列表的行绑定回调
+ * 行按钮被复用时调用,根据序号设置按钮的内容,例如:
+ * lv_label_set_text(lv_list_get_btn_label(btn),logs[index]);
+ */
+using LVListBindCallBack = LVCallBack<void(LVList * list, lv_obj_t * btn, uint32_t index),void>;
+
 /*Data of list*/
 class LVList
         : public LVObject
@@ -366,6 +385,9 @@ public:
      */
     lv_obj_t * getBtnByIndex(int32_t btn_idx)
     {
+        if(m_virtual)
+            return btn_idx < 0 ? nullptr : getVirtualBtn((uint32_t)btn_idx);
+
         lv_obj_t * list = static_cast<lv_obj_t *>(this);
         int index = 0;
         lv_obj_t * btn = lv_list_get_next_btn(list, nullptr);
@@ -383,6 +405,111 @@ public:
         return nullptr;
     }
 
+    /*=====================
+     * Virtual list
+     *====================*/
+
+    /**
+     * @brief 切换为虚拟列表
+     * 只创建可见行和上下 LV_LIST_VIRTUAL_OVERSCAN 行的按钮,滚动时复用移出的按钮,
+     * 由 bind 回调重新设置内容,内存占用与条目数量无关.
+     * 行高固定,序号查找按钮是O(1).
+     * 条目多时滚动区域只覆盖 LV_LIST_VIRTUAL_WINDOW 像素,接近边缘时平移,滚动条只反映这一段.
+     * 虚拟列表中不要再调用 addButton()/clean()/remove().
+     * @param count 条目数量
+     * @param bind 行绑定回调
+     * @param rowHeight 行高
+     */
+    void setVirtual(uint32_t count, LVListBindCallBack bind, lv_coord_t rowHeight);
+
+    /**
+     * @brief 是否为虚拟列表
+     * @return
+     */
+    bool isVirtual() const
+    {
+        return m_virtual;
+    }
+
+    /**
+     * @brief 修改条目数量,可见行重新绑定
+     * @param count
+     */
+    void setItemCount(uint32_t count);
+
+    /**
+     * @brief 条目数量
+     * @return
+     */
+    uint32_t itemCount() const
+    {
+        return m_itemCount;
+    }
+
+    /**
+     * @brief 数据改变后重新绑定所有显示中的行
+     */
+    void refreshVirtual();
+
+    /**
+     * @brief 条目对应的按钮
+     * @param index
+     * @return 条目不在显示中的行时返回nullptr
+     */
+    lv_obj_t * getVirtualBtn(uint32_t index) const;
+
+    /**
+     * @brief 按钮当前绑定的条目序号(在事件回调中使用)
+     * @param btn
+     * @return 不是虚拟列表的行时返回-1
+     */
+    int32_t getVirtualIndex(const lv_obj_t * btn) const;
+
+    /**
+     * @brief 滚动到条目,条目显示在第一行
+     * @param index
+     */
+    void focusVirtual(uint32_t index);
+
+protected:
+    /**
+     * @brief 复用的行
+     */
+    struct Row
+    {
+        lv_obj_t * btn;     //!< 行按钮
+        int32_t index;      //!< 绑定的条目,未绑定为-1
+    };
+
+    /**
+     * @brief 滚动或大小改变后,把移出的行绑定到新进入的条目
+     */
+    void updateVirtual();
+
+    /**
+     * @brief 补足覆盖可见区域的行
+     * @param visible 可见的行数
+     */
+    void ensureRows(uint32_t visible);
+
+    /**
+     * @brief 滚动接近滚动区域的边缘时,平移滚动区域对应的条目
+     * @param scrl
+     * @param viewHeight
+     */
+    void recenterVirtual(lv_obj_t * scrl, lv_coord_t viewHeight);
+
+    static lv_res_t virtualScrlSignal(lv_obj_t * scrl, lv_signal_t sign, void * param);
+
+    LVListBindCallBack m_bindCallBack;  //!< 行绑定回调
+    LVVector<Row> m_rows;               //!< 行按钮,条目 i 在 m_rows[i % size]
+    uint32_t m_itemCount = 0;           //!< 条目数量
+    uint32_t m_windowRows = 0;          //!< 滚动区域覆盖的行数
+    uint32_t m_base = 0;                //!< 滚动区域顶部对应的条目
+    uint32_t m_first = 0;               //!< 第一个绑定的条目
+    lv_coord_t m_rowHeight = 0;         //!< 行高
+    bool m_virtual = false;             //!< 是否为虚拟列表
+    bool m_updating = false;            //!< 正在更新,忽略移动滚动区域产生的信号
 };
 
 #endif /*LV_USE_LIST*/
@@ -1 +1,246 @@
 #include "LVList.h"
+
+#if LV_USE_LIST != 0
+
+/**
+ * 所有列表的滚动区域共用同一个信号函数(lv_page)
+ */
+static lv_signal_cb_t & ancestorScrlSignal()
+{
+    static lv_signal_cb_t s_signal = nullptr;
+    return s_signal;
+}
+
+void LVList::setVirtual(uint32_t count, LVListBindCallBack bind, lv_coord_t rowHeight)
+{
+    if(rowHeight <= 0)
+    {
+        lvError("LVList::setVirtual rowHeight(%d) must be greater than 0",rowHeight);
+        return;
+    }
+
+    //之前的行高可能不同,重新创建行
+    for (uint32_t i = 0; i < m_rows.size(); ++i)
+        lv_obj_del(m_rows[i].btn);
+    m_rows.clear();
+
+    m_bindCallBack = bind;
+    m_rowHeight = rowHeight;
+    m_base = 0;
+    m_first = 0;
+
+    //行按位置摆放,滚动区域的高度由条目数量决定
+    lv_obj_t * scrl = lv_page_get_scrl(this);
+    lv_cont_set_layout(scrl,LV_LAYOUT_OFF);
+    lv_cont_set_fit2(scrl,LV_FIT_FLOOD,LV_FIT_NONE);
+    if(!m_virtual)
+    {
+        lv_signal_cb_t signal = lv_obj_get_signal_cb(scrl);
+        if(ancestorScrlSignal() == nullptr)
+            ancestorScrlSignal() = signal;
+        lv_obj_set_signal_cb(scrl,virtualScrlSignal);
+    }
+    m_virtual = true;
+
+    setItemCount(count);
+}
+
+void LVList::setItemCount(uint32_t count)
+{
+    if(!m_virtual)
+        return;
+
+    m_itemCount = count;
+    uint32_t window = LV_LIST_VIRTUAL_WINDOW / m_rowHeight;
+    m_windowRows = count < window ? count : window;
+    if(m_base + m_windowRows > count)
+        m_base = count - m_windowRows;
+
+    m_updating = true;
+    lv_obj_t * scrl = lv_page_get_scrl(this);
+    lv_obj_set_height(scrl,(lv_coord_t)(m_windowRows * m_rowHeight));
+    m_updating = false;
+
+    refreshVirtual();
+}
+
+void LVList::refreshVirtual()
+{
+    for (uint32_t i = 0; i < m_rows.size(); ++i)
+        m_rows[i].index = -1;
+    updateVirtual();
+}
+
+lv_obj_t *LVList::getVirtualBtn(uint32_t index) const
+{
+    uint32_t size = m_rows.size();
+    if(size == 0 || index < m_first || index >= m_first + size || index >= m_itemCount)
+        return nullptr;
+    return m_rows[index % size].btn;
+}
+
+int32_t LVList::getVirtualIndex(const lv_obj_t *btn) const
+{
+    //行数只和可见区域有关
+    for (uint32_t i = 0; i < m_rows.size(); ++i)
+    {
+        if(m_rows[i].btn == btn)
+            return m_rows[i].index;
+    }
+    return -1;
+}
+
+void LVList::focusVirtual(uint32_t index)
+{
+    if(!m_virtual || index >= m_itemCount)
+        return;
+
+    //目标不在滚动区域中时,先平移滚动区域
+    if(index < m_base || index >= m_base + m_windowRows)
+    {
+        uint32_t base = index > m_windowRows / 2 ? index - m_windowRows / 2 : 0;
+        if(base + m_windowRows > m_itemCount)
+            base = m_itemCount - m_windowRows;
+        m_base = base;
+        for (uint32_t i = 0; i < m_rows.size(); ++i)
+            m_rows[i].index = -1;
+    }
+
+    lv_obj_t * scrl = lv_page_get_scrl(this);
+    lv_coord_t y = -(lv_coord_t)((index - m_base) * m_rowHeight);
+    lv_coord_t scrlHeight = lv_obj_get_height(scrl);
+    lv_coord_t minY = getHeight() - scrlHeight;
+    if(y < minY)
+        y = minY;
+    if(y > 0)
+        y = 0;
+    //移动滚动区域会触发更新
+    lv_obj_set_y(scrl,y);
+    updateVirtual();
+}
+
+void LVList::updateVirtual()
+{
+    if(m_updating || !m_virtual)
+        return;
+    m_updating = true;
+
+    lv_obj_t * scrl = lv_page_get_scrl(this);
+    lv_coord_t viewHeight = getHeight();
+    ensureRows((uint32_t)(viewHeight / m_rowHeight) + 2);
+    recenterVirtual(scrl,viewHeight);
+
+    uint32_t size = m_rows.size();
+    if(size == 0)
+    {
+        m_updating = false;
+        return;
+    }
+
+    lv_coord_t scrlY = lv_obj_get_y(scrl);
+    lv_coord_t top = -scrlY;
+    if(top < 0)
+        top = 0;
+    uint32_t first = m_base + (uint32_t)(top / m_rowHeight);
+    first = first > LV_LIST_VIRTUAL_OVERSCAN ? first - LV_LIST_VIRTUAL_OVERSCAN : 0;
+    if(m_itemCount <= size)
+        first = 0;
+    else if(first + size > m_itemCount)
+        first = m_itemCount - size;
+    m_first = first;
+
+    //只绑定序号改变的行
+    for (uint32_t i = first; i < first + size; ++i)
+    {
+        Row & row = m_rows[i % size];
+        if(i >= m_itemCount)
+        {
+            row.index = -1;
+            lv_obj_set_hidden(row.btn,true);
+            continue;
+        }
+        if(row.index == (int32_t)i)
+            continue;
+
+        row.index = (int32_t)i;
+        lv_obj_set_y(row.btn,(lv_coord_t)(((int32_t)i - (int32_t)m_base) * m_rowHeight));
+        lv_obj_set_hidden(row.btn,false);
+        if(m_bindCallBack)
+            m_bindCallBack(this,row.btn,i);
+    }
+
+    m_updating = false;
+}
+
+void LVList::ensureRows(uint32_t visible)
+{
+    uint32_t count = visible + 2 * LV_LIST_VIRTUAL_OVERSCAN;
+    if(count > m_itemCount)
+        count = m_itemCount;
+    if(count <= m_rows.size())
+        return;
+
+    //行数改变后条目对应的行也改变,全部重新绑定
+    for (uint32_t i = 0; i < m_rows.size(); ++i)
+        m_rows[i].index = -1;
+
+    while (m_rows.size() < count)
+    {
+        lv_obj_t * btn = lv_list_add_btn(this,nullptr,"");
+        lv_cont_set_fit2(btn,LV_FIT_FLOOD,LV_FIT_NONE);
+        lv_obj_set_height(btn,m_rowHeight);
+        lv_obj_set_hidden(btn,true);
+        m_rows.push_back({ btn, -1 });
+    }
+}
+
+void LVList::recenterVirtual(lv_obj_t *scrl, lv_coord_t viewHeight)
+{
+    if(m_itemCount <= m_windowRows)
+        return;
+
+    lv_coord_t y = lv_obj_get_y(scrl);
+    int32_t top = -y;
+    int32_t windowHeight = (int32_t)m_windowRows * m_rowHeight;
+    int32_t margin = windowHeight / 4;
+    bool nearTop = top < margin && m_base > 0;
+    bool nearBottom = top + viewHeight > windowHeight - margin && m_base + m_windowRows < m_itemCount;
+    if(!nearTop && !nearBottom)
+        return;
+
+    //让当前位置回到滚动区域中间
+    uint32_t firstVisible = m_base + (uint32_t)((top > 0 ? top : 0) / m_rowHeight);
+    uint32_t base = firstVisible > m_windowRows / 2 ? firstVisible - m_windowRows / 2 : 0;
+    if(base + m_windowRows > m_itemCount)
+        base = m_itemCount - m_windowRows;
+    if(base == m_base)
+        return;
+
+    int32_t shift = ((int32_t)base - (int32_t)m_base) * m_rowHeight;
+    m_base = base;
+    //拖动是按相对位置移动的,平移不影响正在进行的拖动和惯性滚动
+    lv_obj_set_y(scrl,(lv_coord_t)(y + shift));
+    for (uint32_t i = 0; i < m_rows.size(); ++i)
+    {
+        Row & row = m_rows[i];
+        if(row.index >= 0)
+            lv_obj_set_y(row.btn,(lv_coord_t)((row.index - (int32_t)m_base) * m_rowHeight));
+    }
+}
+
+lv_res_t LVList::virtualScrlSignal(lv_obj_t *scrl, lv_signal_t sign, void *param)
+{
+    lv_res_t res = ancestorScrlSignal()(scrl,sign,param);
+    if(res != LV_RES_OK)
+        return res;
+
+    if(sign == LV_SIGNAL_CORD_CHG || sign == LV_SIGNAL_PARENT_SIZE_CHG)
+    {
+        LVList * list = lvobject_cast<LVList *>(lv_obj_get_parent(scrl));
+        if(list)
+            list->updateVirtual();
+    }
+    return res;
+}
+
+#endif /*LV_USE_LIST*/
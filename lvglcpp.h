@@ -46,8 +46,11 @@ bool lv_cpp_anim_init();
 #include "LVCore/LVCallBack.h"
 #include "LVCore/LVNoCopy.h"
 #include "LVCore/LVPointer.h"
+#include "LVCore/LVPrototype.h"
 #include "LVCore/LVSignal.h"
 #include "LVCore/LVSignalSlot.h"
+#include "LVCore/LVSignalQueue.h"
+#include "LVCore/LVSignalSlotT.h"
 #include "LVCore/LVSlot.h"
 #include "LVCore/LVDispaly.h"
 #include "LVCore/LVGroup.h"
@@ -96,7 +99,10 @@ bool lv_cpp_anim_init();
 ///////////LVMisc//////////////
 #include "LVMisc/LVString.h"
 #include "LVMisc/LVTypes.h"
+#include "LVMisc/LVAnimPath.h"
 #include "LVMisc/LVAnimation.h"
+#include "LVMisc/LVAnimationGroup.h"
+#include "LVMisc/LVPropertyAnimation.h"
 #include "LVMisc/LVArea.h"
 #include "LVMisc/LVColor.h"
 #include "LVMisc/LVFileSystem.h"
@@ -104,7 +110,14 @@ bool lv_cpp_anim_init();
 #include "LVMisc/LVLog.h"
 #include "LVMisc/LVMath.h"
 #include "LVMisc/LVMemory.h"
+#include "LVMisc/LVMemoryPool.h"
+#include "LVMisc/LVMemorySlab.h"
+#include "LVMisc/LVMemoryArena.h"
+#include "LVMisc/LVMemoryTrace.h"
 #include "LVMisc/LVTask.h"
+#include "LVMisc/LVTaskScheduler.h"
+#include "LVMisc/LVTaskProfile.h"
+#include "LVMisc/LVAsyncTask.h"
 #include "LVMisc/LVText.h"
 #include "LVMisc/LVUtils.h"
 